@@ -52,6 +52,7 @@
 #include "amo/AMOTheory.h"
 #include "amo/AMOParser.h"
 #include "core/Optimize.h"
+#include "core/Portfolio.h"
 #include "core/Config.h"
 #include "pb/Config_pb.h"
 #include "monosat/Version.h"
@@ -163,6 +164,8 @@ void selectAlgorithms(){
         mstalg = MinSpanAlg::ALG_PRIM;
     }else if(!strcasecmp(opt_mst_alg, "spira-pan")){
         mstalg = MinSpanAlg::ALG_SPIRA_PAN;
+    }else if(!strcasecmp(opt_mst_alg, "link-cut")){
+        mstalg = MinSpanAlg::ALG_LINK_CUT;
     }else{
         fprintf(stderr, "Error: unknown minimum spanning tree algorithm %s, aborting\n",
                 ((string) opt_mst_alg).c_str());
@@ -187,6 +190,8 @@ void selectAlgorithms(){
         reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED;
     }else if(!strcasecmp(opt_reach_alg, "ramal-reps-batch2")){
         reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED2;
+    }else if(!strcasecmp(opt_reach_alg, "multisource")){
+        reachalg = ReachAlg::ALG_MULTISOURCE;
     }else{
         fprintf(stderr, "Error: unknown reachability algorithm %s, aborting\n", ((string) opt_reach_alg).c_str());
         exit(1);
@@ -208,6 +213,8 @@ void selectAlgorithms(){
         distalg = DistAlg::ALG_RAMAL_REPS_BATCHED;
     }else if(!strcasecmp(opt_dist_alg, "ramal-reps-batch2")){
         distalg = DistAlg::ALG_RAMAL_REPS_BATCHED2;
+    }else if(!strcasecmp(opt_dist_alg, "es-tree")){
+        distalg = DistAlg::ALG_EVEN_SHILOACH;
     }else{
         fprintf(stderr, "Error: unknown distance algorithm %s, aborting\n", ((string) opt_dist_alg).c_str());
         exit(1);
@@ -597,6 +604,11 @@ int main(int argc, char** argv){
         S.max_priority_var = opt_max_priority_decision_var - 1;
 
         S.setPBSolver(new PB::PbSolver(S));
+        if(strlen(opt_proof) > 0){
+            S.proof = new ProofWriter(opt_proof, opt_proof_binary, opt_proof_premises);
+            if(!S.proof->isValid())
+                printf("ERROR! Could not open proof file: %s\n", (const char*) opt_proof), exit(1);
+        }
 
         if(opt_min_decision_var > 1 || opt_max_decision_var > 0){
             printf(
@@ -665,7 +677,7 @@ int main(int argc, char** argv){
                     fprintf(stderr,
                             "Warning: Solver will give completely bogus answers if 'solve' statements are processed while variable remapping is disabled (e.g., -no-remap-vars)\n\n");
                 }
-                optimize_and_solve(S, parser.assumptions, parser.objectives, false, found_optimal);
+                solvePortfolio(S, parser.assumptions, parser.objectives, false, found_optimal, opt_portfolio);
             }else{
                 parser.assumptions.clear();
             }
@@ -721,7 +733,7 @@ int main(int argc, char** argv){
         }
 
 
-        lbool ret = optimize_and_solve(S, parser.assumptions, parser.objectives, false, found_optimal);
+        lbool ret = solvePortfolio(S, parser.assumptions, parser.objectives, false, found_optimal, opt_portfolio);
         double solving_time = rtime(0) - after_preprocessing;
         if(opt_verb > 0){
             printf("Solving time = %f\n", solving_time);
@@ -34,6 +34,7 @@
 #include "monosat/pb/PbParser.h"
 #include "monosat/amo/AMOParser.h"
 #include "monosat/core/Optimize.h"
+#include "monosat/core/Portfolio.h"
 #include "monosat/pb/PbSolver.h"
 #include "monosat/routing/FlowRouter.h"
 #include "monosat/Version.h"
@@ -218,6 +219,8 @@ void _selectAlgorithms(){
         mstalg = MinSpanAlg::ALG_PRIM;
     }else if(!strcasecmp(opt_mst_alg, "spira-pan")){
         mstalg = MinSpanAlg::ALG_SPIRA_PAN;
+    }else if(!strcasecmp(opt_mst_alg, "link-cut")){
+        mstalg = MinSpanAlg::ALG_LINK_CUT;
     }else{
         api_errorf("Error: unknown minimum spanning tree algorithm %s, aborting\n",
                    ((string) opt_mst_alg).c_str());
@@ -242,6 +245,8 @@ void _selectAlgorithms(){
         reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED;
     }else if(!strcasecmp(opt_reach_alg, "ramal-reps-batch2")){
         reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED2;
+    }else if(!strcasecmp(opt_reach_alg, "multisource")){
+        reachalg = ReachAlg::ALG_MULTISOURCE;
     }else{
         api_errorf("Error: unknown reachability algorithm %s, aborting\n", ((string) opt_reach_alg).c_str());
 
@@ -263,6 +268,8 @@ void _selectAlgorithms(){
         distalg = DistAlg::ALG_RAMAL_REPS_BATCHED;
     }else if(!strcasecmp(opt_dist_alg, "ramal-reps-batch2")){
         distalg = DistAlg::ALG_RAMAL_REPS_BATCHED2;
+    }else if(!strcasecmp(opt_dist_alg, "es-tree")){
+        distalg = DistAlg::ALG_EVEN_SHILOACH;
     }else{
         api_errorf("Error: unknown distance algorithm %s, aborting\n", ((string) opt_dist_alg).c_str());
 
@@ -497,6 +504,12 @@ Monosat::SimpSolver* newSolver_args(int argc, char** argv){
     _selectAlgorithms();
     Monosat::SimpSolver* S = new Monosat::SimpSolver();
     solvers.insert(S);//add S to the list of solvers handled by signals
+    if(strlen(opt_proof) > 0){
+        S->proof = new ProofWriter(opt_proof, opt_proof_binary, opt_proof_premises);
+        if(!S->proof->isValid()){
+            throw std::runtime_error("Could not open proof file");
+        }
+    }
 
 
     S->_external_data = (void*) new MonosatData(S);
@@ -944,7 +957,7 @@ int nLearnedClauses(Monosat::SimpSolver* S){
     return S->nLearnts();
 }
 
-int _solve(Monosat::SimpSolver* S, int* assumptions, int n_assumptions){
+int _solve(Monosat::SimpSolver* S, int* assumptions, int n_assumptions, int n_workers = opt_portfolio){
     bool found_optimal = true;
     MonosatData* d = (MonosatData*) S->_external_data;
     d->last_solution_optimal = true;
@@ -980,7 +993,7 @@ int _solve(Monosat::SimpSolver* S, int* assumptions, int n_assumptions){
     if(d->pbsolver){
         d->pbsolver->convert();
     }
-    lbool r = optimize_and_solve(*S, assume, objectives, opt_pre, found_optimal);
+    lbool r = solvePortfolio(*S, assume, objectives, opt_pre, found_optimal, n_workers);
     disableTimeLimit(S);
     d->last_solution_optimal = found_optimal;
     if(r == l_False){
@@ -1006,6 +1019,14 @@ int solveAssumptionsLimited(Monosat::SimpSolver* S, int* assumptions, int n_assu
     //return solveAssumptionsLimited_MinBVs(S,assumptions,n_assumptions,nullptr,0);
 }
 
+int solveParallel(Monosat::SimpSolver* S, int n_workers){
+    return solveAssumptionsParallel(S, nullptr, 0, n_workers);
+}
+
+int solveAssumptionsParallel(Monosat::SimpSolver* S, int* assumptions, int n_assumptions, int n_workers){
+    return _solve(S, assumptions, n_assumptions, n_workers);
+}
+
 bool solveAssumptions(Monosat::SimpSolver* S, int* assumptions, int n_assumptions){
     setTimeLimit(S, -1);//clear the time limit, if any
     S->budgetOff();//solve() and solveAssumtpions() ignore resource limits
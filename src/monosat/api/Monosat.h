@@ -119,6 +119,14 @@ int solveLimited(SolverPtr S);
 //Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
 int solveAssumptionsLimited(SolverPtr S, int* assumptions, int n_assumptions);
 
+//Solve using a portfolio of n_workers diversified solver processes, taking the first answer found.
+//Resource limits are respected, as in solveLimited(). Workers are forked from the calling process, so this should not be
+//used from hosts with other running threads (such as the JVM). Falls back to sequential solving if n_workers <= 1.
+//Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
+int solveParallel(SolverPtr S, int n_workers);
+//Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
+int solveAssumptionsParallel(SolverPtr S, int* assumptions, int n_assumptions, int n_workers);
+
 //Solve under assumptions, and also minimize a set of BVs (in order of precedence)
 //Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
 //int solveAssumptionsLimited_MinBVs(SolverPtr S,int * assumptions, int n_assumptions, int * minimize_bvs, int n_minimize_bvs);
@@ -261,6 +261,14 @@ class Monosat(metaclass=Singleton):
             ]
             self.monosat_c.solveAssumptionsLimited.restype = c_int
 
+            self.monosat_c.solveAssumptionsParallel.argtypes = [
+                c_solver_p,
+                c_literal_p,
+                c_int,
+                c_int,
+            ]
+            self.monosat_c.solveAssumptionsParallel.restype = c_int
+
             self.monosat_c.lastSolutionWasOptimal.argtypes = [c_solver_p]
             self.monosat_c.lastSolutionWasOptimal.restype = c_bool
 
@@ -1090,6 +1098,25 @@ class Monosat(metaclass=Singleton):
             assert r == 2
             return None
 
+    def solveParallel(self, n_workers, assumptions=None):
+        self.backtrack()
+        if assumptions is None:
+            assumptions = []
+
+        lp = self.getIntArray(assumptions)
+
+        r = self.monosat_c.solveAssumptionsParallel(
+            self.solver._ptr, lp, len(assumptions), n_workers
+        )
+
+        if r == 0:
+            return True
+        elif r == 1:
+            return False
+        else:
+            assert r == 2
+            return None
+
     def backtrack(self):
         return self.monosat_c.backtrack(self.solver._ptr)
 
@@ -0,0 +1,159 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include "monosat/utils/System.h"
+#include "monosat/utils/Options.h"
+#include "monosat/mtl/Rnd.h"
+#include "monosat/dgl/DynamicGraph.h"
+#include "monosat/dgl/Dijkstra.h"
+#include "monosat/dgl/RamalReps.h"
+#include "monosat/dgl/EvenShiloach.h"
+
+using namespace Monosat;
+using namespace dgl;
+
+namespace {
+typedef int64_t Weight;
+
+//Times one single-source distance algorithm over a sequence of edge deletions and (backtracking) re-insertions,
+//applied to a shared graph as a solver would while searching over the edge literals.
+struct TimedDistance {
+    const char* name;
+    Distance<Weight>* alg;
+    double time;
+    int64_t mismatches;
+};
+
+//Returns true if 'd' agrees with the reference distances for all nodes within 'horizon' (or all nodes, if horizon<0).
+bool agrees(DynamicGraph<Weight>& g, Distance<Weight>& ref, Distance<Weight>& d, Weight horizon){
+    for(int n = 0; n < g.nodes(); n++){
+        bool in_ref = ref.connected(n) && (horizon < 0 || ref.distance(n) <= horizon);
+        bool in_d = d.connected(n) && (horizon < 0 || d.distance(n) <= horizon);
+        if(in_ref != in_d || (in_ref && ref.distance(n) != d.distance(n)))
+            return false;
+    }
+    return true;
+}
+}
+
+int main(int argc, char** argv){
+    try{
+        setUsageHelp("USAGE: %s [options]\n\n  Times dynamic shortest path algorithms on a random weighted graph.\n");
+        IntOption opt_nodes("BENCH", "nodes", "Number of nodes", 20000, IntRange(2, INT32_MAX));
+        IntOption opt_edges("BENCH", "edges", "Number of edges", 100000, IntRange(1, INT32_MAX));
+        IntOption opt_weight("BENCH", "max-weight", "Edge weights are drawn uniformly from [1,max-weight]", 100,
+                             IntRange(1, INT32_MAX));
+        Int64Option opt_horizon("BENCH", "horizon",
+                                "Distance horizon for the bounded Even-Shiloach tree (-1 to disable)", 500,
+                                Int64Range(-1, INT64_MAX));
+        IntOption opt_steps("BENCH", "steps", "Number of edge deletion steps", 2000, IntRange(1, INT32_MAX));
+        IntOption opt_batch("BENCH", "batch", "Edges deleted per step", 10, IntRange(1, INT32_MAX));
+        IntOption opt_depth("BENCH", "depth", "Backtrack after this many steps on average", 50,
+                            IntRange(1, INT32_MAX));
+        BoolOption opt_check("BENCH", "check", "Compare all distances against Dijkstra after every step", true);
+        BoolOption opt_stats("BENCH", "stats", "Print each algorithm's statistics", false);
+        parseOptions(argc, argv, true);
+
+        double seed = 91648253;
+        DynamicGraph<Weight> g;
+        for(int i = 0; i < opt_nodes; i++)
+            g.addNode();
+        for(int i = 0; i < opt_edges; i++){
+            int from = irand(seed, opt_nodes);
+            int to = irand(seed, opt_nodes);
+            g.addEdge(from, to, -1, 1 + irand(seed, opt_weight));
+        }
+        Weight horizon = opt_horizon;
+
+        Dijkstra<Weight> dijkstra(0, g);
+        RamalReps<Weight> ramal_reps(0, g);
+        EvenShiloach<Weight> es(0, g);
+        EvenShiloach<Weight> es_bounded(0, g);
+        if(horizon >= 0)
+            es_bounded.setMaxDistance(horizon);
+        std::vector<TimedDistance> algs = {{"dijkstra",     &dijkstra,   0, 0},
+                                           {"ramal-reps",   &ramal_reps, 0, 0},
+                                           {"es-tree",      &es,         0, 0},
+                                           {"es-tree(max)", &es_bounded, 0, 0}};
+
+        //Each level of the trail records the edges disabled at that level, so that backtracking can re-enable them
+        std::vector<std::vector<int>> trail;
+        int64_t deletions = 0;
+        int64_t insertions = 0;
+        for(int step = 0; step < opt_steps; step++){
+            if(!trail.empty() && irand(seed, opt_depth) == 0){
+                int target = irand(seed, (int) trail.size());
+                while((int) trail.size() > target){
+                    for(int edgeID:trail.back()){
+                        g.enableEdge(edgeID);
+                        insertions++;
+                    }
+                    trail.pop_back();
+                }
+            }else{
+                trail.emplace_back();
+                for(int i = 0; i < opt_batch; i++){
+                    int edgeID = irand(seed, g.edges());
+                    if(g.edgeEnabled(edgeID)){
+                        g.disableEdge(edgeID);
+                        trail.back().push_back(edgeID);
+                        deletions++;
+                    }
+                }
+            }
+            for(TimedDistance& t:algs){
+                double start = cpuTime();
+                t.alg->update();
+                t.time += cpuTime() - start;
+            }
+            if(opt_check){
+                for(TimedDistance& t:algs){
+                    if(!agrees(g, dijkstra, *t.alg, t.alg == &es_bounded ? horizon : -1))
+                        t.mismatches++;
+                }
+            }
+            g.clearChanged();
+            g.clearHistory();
+        }
+        printf("%d nodes, %d edges, %" PRId64 " deletions, %" PRId64 " insertions over %d steps\n", g.nodes(),
+               g.edges(), deletions, insertions, (int) opt_steps);
+        bool ok = true;
+        for(TimedDistance& t:algs){
+            printf("%-14s %8.3f s", t.name, t.time);
+            if(opt_check){
+                printf("  (%" PRId64 " mismatching steps)", t.mismatches);
+                ok &= t.mismatches == 0;
+            }
+            printf("\n");
+            if(opt_stats)
+                t.alg->printStats();
+        }
+        return ok ? 0 : 1;
+    }catch(parse_error& e){
+        std::cerr << "Parsing error:\n" << e.what() << std::endl;
+        return 1;
+    }
+}
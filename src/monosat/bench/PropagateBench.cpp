@@ -0,0 +1,125 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+//Microbenchmark for Boolean constraint propagation: loads a CNF, then repeatedly assigns random decisions and
+//propagates them (backtracking on conflicts, and whenever the trail is full), reporting propagations per second.
+//No clauses are learnt, so the clause database (and so the work per propagation) stays fixed across runs.
+
+#include <zlib.h>
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include "monosat/utils/System.h"
+#include "monosat/utils/ParseUtils.h"
+#include "monosat/utils/Options.h"
+#include "monosat/mtl/Rnd.h"
+#include "monosat/core/Dimacs.h"
+#include "monosat/simp/SimpSolver.h"
+
+using namespace Monosat;
+
+namespace {
+class PropagateBench : public SimpSolver {
+public:
+    using Solver::propagate;
+
+    //Returns the number of decisions made.
+    uint64_t run(uint64_t max_props, int max_depth, double seed){
+        uint64_t decisions = 0;
+        uint64_t start_props = propagations;
+        cancelUntil(0);
+        if(!ok || propagate(false) != CRef_Undef)
+            return 0;
+        int n_free = 0;
+        for(Var v = 0; v < nVars(); v++){
+            if(value(v) == l_Undef)
+                n_free++;
+        }
+        if(n_free == 0)
+            return 0;
+        while(propagations - start_props < max_props){
+            if(decisionLevel() >= max_depth || trail.size() == nVars())
+                cancelUntil(0);
+            Var v;
+            do{
+                v = irand(seed, nVars());
+            }while(value(v) != l_Undef);
+            newDecisionLevel();
+            uncheckedEnqueue(mkLit(v, drand(seed) < 0.5));
+            decisions++;
+            if(propagate(false) != CRef_Undef){
+                //backjump part of the way, roughly as conflict analysis would
+                cancelUntil(decisionLevel() / 2);
+            }
+        }
+        cancelUntil(0);
+        return decisions;
+    }
+};
+}
+
+int main(int argc, char** argv){
+    try{
+        setUsageHelp("USAGE: %s [options] <input-file>\n\n  where input may be either in plain or gzipped DIMACS.\n");
+        Int64Option opt_props("BENCH", "props", "Number of propagations to perform", 100000000,
+                              Int64Range(1, INT64_MAX));
+        IntOption opt_depth("BENCH", "depth", "Backtrack to level 0 after this many decisions", 1000,
+                            IntRange(1, INT32_MAX));
+        IntOption opt_repeats("BENCH", "repeats", "Number of timed runs", 3, IntRange(1, INT32_MAX));
+        parseOptions(argc, argv, true);
+
+        gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
+        if(in == nullptr){
+            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]);
+            return 1;
+        }
+        PropagateBench S;
+        S.eliminate(true);//no preprocessing: the benchmark should propagate the clauses as given
+        Dimacs<StreamBuffer, SimpSolver> parser;
+        double parse_start = cpuTime();
+        {
+            StreamBuffer strm(in);
+            while(S.okay() && parser.parse(strm, S)){
+            }
+        }
+        gzclose(in);
+        printf("Parsed %d variables, %d clauses in %.2f s\n", S.nVars(), S.nClauses(), cpuTime() - parse_start);
+        if(!S.okay()){
+            printf("Instance is trivially UNSAT\n");
+            return 0;
+        }
+        double seed = 91648253;
+        for(int r = 0; r < opt_repeats; r++){
+            uint64_t start_props = S.propagations;
+            double start = cpuTime();
+            uint64_t decisions = S.run(opt_props, opt_depth, seed);
+            double elapsed = cpuTime() - start;
+            uint64_t props = S.propagations - start_props;
+            printf("run %d: %" PRIu64 " propagations, %" PRIu64 " decisions in %.3f s (%.0f propagations/sec)\n", r,
+                   props, decisions, elapsed, elapsed > 0 ? props / elapsed : 0.0);
+            seed += 1;
+        }
+        return 0;
+    }catch(parse_error& e){
+        std::cerr << "Parsing error:\n" << e.what() << std::endl;
+        return 1;
+    }
+}
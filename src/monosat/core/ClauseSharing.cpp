@@ -0,0 +1,128 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/ClauseSharing.h"
+
+#if not defined(__MINGW32__)
+#include <sys/mman.h>
+#endif
+
+namespace Monosat {
+
+ClauseSharing::ClauseSharing(int n_slots){
+#if not defined(__MINGW32__)
+    if(n_slots <= 0)
+        return;
+    size_t bytes = sizeof(Buffer) + sizeof(Slot) * (n_slots - 1);
+    void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(mem == MAP_FAILED)
+        return;
+    //Anonymous mappings are zero-filled, which is a valid initial state for every slot (no slot is complete).
+    buffer = (Buffer*) mem;
+    this->n_slots = n_slots;
+    mapped_bytes = bytes;
+#endif
+}
+
+ClauseSharing::~ClauseSharing(){
+#if not defined(__MINGW32__)
+    if(buffer){
+        munmap(buffer, mapped_bytes);
+    }
+#endif
+}
+
+void ClauseSharing::attach(int worker_id, int n_shared_vars){
+    this->worker_id = worker_id;
+    this->n_shared_vars = n_shared_vars;
+    read_pos = 0;
+    stalled_pos = UINT64_MAX;
+}
+
+bool ClauseSharing::exportClause(const vec<Lit>& clause){
+    if(!buffer || worker_id < 0 || clause.size() == 0 || clause.size() > max_clause_size)
+        return false;
+    for(Lit l:clause){
+        if(var(l) >= n_shared_vars)
+            return false;
+    }
+    uint64_t index = buffer->head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = buffer->slots[index % n_slots];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.worker.store(worker_id, std::memory_order_relaxed);
+    slot.size.store(clause.size(), std::memory_order_relaxed);
+    for(int i = 0; i < clause.size(); i++){
+        slot.lits[i].store(toInt(clause[i]), std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    stats_exported++;
+    return true;
+}
+
+bool ClauseSharing::importClause(vec<Lit>& out){
+    if(!buffer || worker_id < 0)
+        return false;
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    if(head > read_pos + n_slots){
+        //This reader fell more than a full lap behind; skip the clauses that have already been overwritten.
+        stats_dropped += head - n_slots - read_pos;
+        read_pos = head - n_slots;
+    }
+    while(read_pos < head){
+        Slot& slot = buffer->slots[read_pos % n_slots];
+        uint64_t expect = 2 * read_pos + 2;
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if(seq < expect){
+            //The writer has not finished this slot yet. Try again later, but don't wait on the same slot forever
+            //(two writers a full lap apart can leave a slot with a stale sequence number).
+            if(stalled_pos != read_pos){
+                stalled_pos = read_pos;
+                return false;
+            }
+            stats_dropped++;
+            read_pos++;
+            continue;
+        }else if(seq > expect){
+            //Already overwritten by a later clause.
+            stats_dropped++;
+            read_pos++;
+            continue;
+        }
+        int from = slot.worker.load(std::memory_order_relaxed);
+        int sz = slot.size.load(std::memory_order_relaxed);
+        out.clear();
+        for(int i = 0; i < sz && i < max_clause_size; i++){
+            out.push(toLit(slot.lits[i].load(std::memory_order_relaxed)));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        bool overwritten = slot.seq.load(std::memory_order_relaxed) != seq;
+        read_pos++;
+        if(overwritten){
+            stats_dropped++;
+        }else if(from != worker_id && sz > 0 && sz <= max_clause_size){
+            stats_imported++;
+            return true;
+        }
+    }
+    return false;
+}
+};
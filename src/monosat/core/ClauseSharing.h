@@ -0,0 +1,91 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef CLAUSESHARING_H_
+#define CLAUSESHARING_H_
+
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace Monosat {
+
+//A lock-free, multi-producer ring buffer of short clauses, used to exchange learnt clauses between portfolio workers.
+//The buffer is allocated in anonymous shared memory, so it remains shared between processes created by fork();
+//everything else in this object (the worker id and read position) is private to each process.
+//Each slot is protected by a sequence number (a seqlock), so readers never block writers; if a reader falls more than
+//one lap behind, the clauses it missed are dropped.
+class ClauseSharing {
+public:
+    static const int max_clause_size = 16;
+
+    //Allocate a buffer with room for n_slots clauses. Check isValid() afterwards.
+    explicit ClauseSharing(int n_slots);
+
+    ~ClauseSharing();
+
+    ClauseSharing(const ClauseSharing&) = delete;
+
+    ClauseSharing& operator=(const ClauseSharing&) = delete;
+
+    bool isValid() const{
+        return buffer != nullptr;
+    }
+
+    //Called in each worker after forking, before exporting or importing any clauses.
+    //Only clauses over variables < n_shared_vars (those that existed before the workers were created, and so have the
+    //same meaning in every worker) are exported.
+    void attach(int worker_id, int n_shared_vars);
+
+    //Publish a clause to the other workers. Returns false if the clause was not exported, because it is too long
+    //or contains non-shared variables (e.g., theory atoms created lazily in this worker).
+    bool exportClause(const vec<Lit>& clause);
+
+    //Read the next clause published by another worker into 'out'. Returns false if there are no new clauses.
+    bool importClause(vec<Lit>& out);
+
+    int64_t stats_exported = 0;
+    int64_t stats_imported = 0;
+    int64_t stats_dropped = 0;
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;//2*index+1 while slot 'index' is being written, 2*index+2 once it is complete
+        std::atomic<int32_t> worker;
+        std::atomic<int32_t> size;
+        std::atomic<int32_t> lits[max_clause_size];
+    };
+    struct Buffer {
+        std::atomic<uint64_t> head;
+        Slot slots[1];
+    };
+
+    Buffer* buffer = nullptr;
+    size_t n_slots = 0;
+    size_t mapped_bytes = 0;
+    int worker_id = -1;
+    int n_shared_vars = 0;
+    uint64_t read_pos = 0;
+    uint64_t stalled_pos = UINT64_MAX;
+};
+};
+#endif /* CLAUSESHARING_H_ */
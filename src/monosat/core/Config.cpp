@@ -71,6 +71,29 @@ DoubleOption Monosat::opt_garbage_frac(_cat, "gc-frac",
                                        0.20,
                                        DoubleRange(0, false, HUGE_VAL, false));
 BoolOption Monosat::opt_pre("MAIN", "pre", "Completely turn on/off any preprocessing.", true);
+IntOption Monosat::opt_portfolio("MAIN", "portfolio",
+                                 "Number of diversified solver processes to run in parallel (1 solves sequentially)", 1,
+                                 IntRange(1, INT32_MAX));
+BoolOption Monosat::opt_share_clauses("MAIN", "share-clauses",
+                                      "Exchange short learnt clauses between portfolio workers (ignored when optimizing)",
+                                      true);
+IntOption Monosat::opt_share_max_size("MAIN", "share-max-size", "Maximum size of learnt clauses shared between workers",
+                                      8, IntRange(1, 16));
+IntOption Monosat::opt_share_max_lbd("MAIN", "share-max-lbd",
+                                     "Maximum literal block distance of learnt clauses shared between workers", 3,
+                                     IntRange(1, 16));
+IntOption Monosat::opt_cube_depth("MAIN", "cube-depth",
+                                  "If >0, solve by cube-and-conquer, splitting on up to this many graph edge literals (0 disables)",
+                                  0, IntRange(0, 30));
+IntOption Monosat::opt_cube_candidates("MAIN", "cube-candidates",
+                                       "Number of highest scoring splitting literals to consider when splitting cubes", 64,
+                                       IntRange(1, INT32_MAX));
+StringOption Monosat::opt_cube_file("MAIN", "cube-file",
+                                    "Write the cubes generated for cube-and-conquer to this file (empty string disables)",
+                                    "");
+IntOption Monosat::opt_share_buffer_size("MAIN", "share-buffer",
+                                         "Number of clauses held in the buffer shared between portfolio workers",
+                                         1 << 16, IntRange(1, INT32_MAX));
 IntOption Monosat::opt_time(_cat, "verb-time", "Detail level of timing benchmarks (these add some overhead)", 0,
                             IntRange(0, 5));
 
@@ -102,6 +125,13 @@ BoolOption Monosat::opt_debug_model(_cat, "debug-model", "", false);
 StringOption Monosat::opt_debug_learnt_clauses(_cat, "debug-learnts",
                                                "Write all learned clauses to the following file (empty string (recommended) disables)", "");
 FILE* Monosat::opt_write_learnt_clauses = nullptr;
+StringOption Monosat::opt_proof(_cat, "proof",
+                                "Write a DRAT proof of unsatisfiability to this file (empty string disables)", "");
+BoolOption Monosat::opt_proof_binary(_cat, "proof-binary", "Write the DRAT proof in binary (rather than text) format",
+                                     true);
+StringOption Monosat::opt_proof_premises(_cat, "proof-premises",
+                                         "Write the clauses given to the solver, and all theory lemmas, to this DIMACS file, to check the DRAT proof against (empty string disables)",
+                                         "");
 
 //StringOption Monosat::StringOption opt_fsm_model(_cat_fsm,"File to write fsm model, if fsm theory is used","","");
 
@@ -194,16 +224,16 @@ StringOption Monosat::opt_maxflow_alg(_cat_graph, "maxflow",
                                       "Select max s-t-flow algorithm (edmondskarp, edmondskarp-adj, edmondskarp-dynamic,dinitz,dinitz-linkcut, kohli-torr)",
                                       "kohli-torr"); //ibfs
 StringOption Monosat::opt_reach_alg(_cat_graph, "reach",
-                                    "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf)", "ramal-reps");
+                                    "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,multisource,cnf)", "ramal-reps");
 StringOption Monosat::opt_dist_alg(_cat_graph, "dist",
-                                   "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf)", "ramal-reps");
+                                   "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,es-tree,cnf)", "ramal-reps");
 
 StringOption Monosat::opt_con_alg(_cat_graph, "connect",
                                   "Select undirected reachability algorithm (bfs,dfs, dijkstra, thorup,cnf)", "bfs");
 StringOption Monosat::opt_undir_allpairs_alg(_cat_graph, "connect-allpairs",
                                              "Select allpairs reachability algorithm (floyd-warshall,dijkstra, thorup)",
                                              "floyd-warshall");
-StringOption Monosat::opt_mst_alg(_cat_graph, "mst", "Select minimum spanning tree algorithm (kruskal,prim,spira-pan)",
+StringOption Monosat::opt_mst_alg(_cat_graph, "mst", "Select minimum spanning tree algorithm (kruskal,prim,spira-pan,link-cut)",
                                   "spira-pan");
 
 StringOption Monosat::opt_allpairs_alg(_cat_graph, "allpairs",
@@ -227,6 +257,9 @@ BoolOption Monosat::opt_conflict_1uip(_cat_graph, "conflict-1uip",
 BoolOption Monosat::opt_conflict_min_cut_maxflow(_cat_graph, "conflict-min-cut-maxflow",
                                                  "Use min-cut (instead of arbitrary cut) for conflict resolution for maximum flow properties",
                                                  false);
+IntOption Monosat::opt_conflict_min_cut_cache(_cat_graph, "conflict-min-cut-cache",
+                                              "Number of recent maximum flow min-cuts to remember, and reuse as conflicts for as long as all of their edges remain disabled (0 to disable)",
+                                              8, IntRange(0, INT32_MAX));
 
 IntOption Monosat::opt_history_clear(_cat_graph, "history-clear",
                                      "Rate at which the history of dynamic graphs is cleared", 1000,
@@ -334,6 +367,47 @@ BoolOption Monosat::opt_force_directed(_cat_graph, "force-directed",
 
 BoolOption Monosat::opt_rnd_restart(_cat, "rnd-restart", "Randomize activity on restart", false);
 BoolOption Monosat::opt_rnd_theory_restart(_cat, "rnd-theory-restart", "Randomize theory activity on restart", false);
+BoolOption Monosat::opt_inprocess(_cat, "inprocess",
+                                  "Periodically subsume and vivify learnt clauses at restarts (and eliminate variables, if preprocessing is still enabled)",
+                                  false);
+IntOption Monosat::opt_inprocess_interval(_cat, "inprocess-interval",
+                                          "Number of conflicts before the first inprocessing round (the interval grows by this amount after each round)",
+                                          5000, IntRange(1, INT32_MAX));
+IntOption Monosat::opt_vivify_max(_cat, "vivify-max",
+                                  "Maximum number of learnt clauses to vivify in each inprocessing round", 2000,
+                                  IntRange(0, INT32_MAX));
+BoolOption Monosat::opt_lbd_tiers(_cat, "lbd-tiers",
+                                  "Manage learnt clauses in three tiers by LBD (core/tier2/local), rather than by activity alone",
+                                  true);
+IntOption Monosat::opt_lbd_core(_cat, "lbd-core", "Learnt clauses with at most this LBD are never removed", 2,
+                                IntRange(0, INT32_MAX));
+IntOption Monosat::opt_lbd_tier2(_cat, "lbd-tier2",
+                                 "Learnt clauses with at most this LBD are kept as long as they are used in conflict analysis",
+                                 6, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_tier2_unused(_cat, "tier2-unused",
+                                    "Number of conflicts without use before a tier2 clause is demoted to the local tier",
+                                    30000, IntRange(1, INT32_MAX));
+IntOption Monosat::opt_theory_lemma_unused(_cat, "theory-lemma-unused",
+                                           "Number of conflicts without use before a learnt theory lemma is demoted to the local tier",
+                                           100000, IntRange(1, INT32_MAX));
+IntOption Monosat::opt_chrono_backtrack(_cat, "chrono",
+                                        "Backtrack chronologically (by a single level) when a conflict would otherwise backjump over more than this many decision levels (-1 to disable)",
+                                        100, IntRange(-1, INT32_MAX));
+IntOption Monosat::opt_mode_switch(_cat, "mode-switch",
+                                   "Alternate between focused mode (EMA restarts) and stable mode (rare Luby restarts, target phases), starting with a focused phase of this many conflicts (0 to disable)",
+                                   0, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_stable_restart_first(_cat, "stable-rfirst",
+                                            "The base (Luby) restart interval in stable mode", 1024,
+                                            IntRange(1, INT32_MAX));
+DoubleOption Monosat::opt_restart_margin(_cat, "restart-margin",
+                                         "In focused mode, restart when the fast LBD average exceeds the slow LBD average by this factor",
+                                         1.25, DoubleRange(1, true, HUGE_VAL, false));
+IntOption Monosat::opt_rephase_interval(_cat, "rephase-interval",
+                                        "Number of conflicts between resets of the saved phases to the best/inverted/random phases in stable mode (0 to disable)",
+                                        1000, IntRange(0, INT32_MAX));
+BoolOption Monosat::opt_theory_target_phase(_cat, "theory-target-phase",
+                                            "In stable mode, theory decisions follow the target phase of their decision literal",
+                                            true);
 
 IntOption Monosat::opt_learn_reaches(_cat_graph, "learn-reach",
                                      "Learn using reach variables: 0 = Never, 1=Paths, 2=Cuts,3=Always", 0,
@@ -395,6 +469,9 @@ BoolOption Monosat::opt_ignore_theories(_cat_graph, "ignore-theories", "", false
 //BoolOption Minisat::opt_check_pure_theory_lits(_cat_graph,"pure-theory-lits","",false);
 
 BoolOption Monosat::opt_decide_graph_chokepoints(_cat_graph, "decide-graph-chokepoints", "", false);
+BoolOption Monosat::opt_graph_csr(_cat_graph, "graph-csr",
+                                   "With -reach=bfs, traverse compressed (CSR) snapshots of the graphs' adjacency lists",
+                                   false);
 IntOption Monosat::opt_sort_graph_decisions(_cat_graph, "decide-graph-sort",
                                             "0=dont sort, 1=sort by shortest, 2=sort by longest", 0, IntRange(0, 2));
 
@@ -518,6 +595,10 @@ IntOption  Monosat::opt_graph_prop_skip(_cat_graph, "graph-theory-skip",
                                         "Only process every nth graph theory propagation ('1' skips no propagations)",
                                         1, IntRange(1, INT32_MAX));
 
+IntOption  Monosat::opt_graph_prop_threads(_cat_graph, "graph-prop-threads",
+                                           "Number of threads used to bring the graph detectors' dynamic algorithms up to date before each graph theory propagation ('0' or '1' updates them sequentially, as they are propagated)",
+                                           0, IntRange(0, 256));
+
 IntOption  Monosat::opt_bv_prop_skip(_cat_bv, "bv-theory-skip",
                                      "Only process every nth bv theory propagation ('1' skips no propagations)", 1,
                                      IntRange(1, INT32_MAX));
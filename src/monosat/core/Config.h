@@ -29,6 +29,14 @@ extern BoolOption opt_show_version_and_quit;
 extern IntOption opt_verb;
 extern IntOption opt_verb_optimize;
 extern BoolOption opt_pre;
+extern IntOption opt_portfolio;
+extern BoolOption opt_share_clauses;
+extern IntOption opt_share_max_size;
+extern IntOption opt_share_max_lbd;
+extern IntOption opt_share_buffer_size;
+extern IntOption opt_cube_depth;
+extern IntOption opt_cube_candidates;
+extern StringOption opt_cube_file;
 extern DoubleOption opt_var_decay;
 extern DoubleOption opt_clause_decay;
 extern DoubleOption opt_theory_decay;
@@ -44,6 +52,20 @@ extern DoubleOption opt_garbage_frac;
 extern BoolOption opt_restarts;
 extern BoolOption opt_rnd_restart;
 extern BoolOption opt_rnd_theory_restart;
+extern BoolOption opt_inprocess;
+extern IntOption opt_inprocess_interval;
+extern IntOption opt_vivify_max;
+extern BoolOption opt_lbd_tiers;
+extern IntOption opt_lbd_core;
+extern IntOption opt_lbd_tier2;
+extern IntOption opt_tier2_unused;
+extern IntOption opt_theory_lemma_unused;
+extern IntOption opt_chrono_backtrack;
+extern IntOption opt_mode_switch;
+extern IntOption opt_stable_restart_first;
+extern DoubleOption opt_restart_margin;
+extern IntOption opt_rephase_interval;
+extern BoolOption opt_theory_target_phase;
 extern StringOption opt_record_file;
 extern IntOption opt_limit_optimization_conflicts;
 extern IntOption opt_limit_optimization_time;
@@ -82,6 +104,9 @@ extern int64_t opt_n_learnts;
 extern BoolOption opt_write_bv_bounds;
 extern BoolOption opt_write_bv_analysis;
 extern FILE* opt_write_learnt_clauses;
+extern StringOption opt_proof;
+extern BoolOption opt_proof_binary;
+extern StringOption opt_proof_premises;
 
 //extern StringOption opt_fsm_model;
 
@@ -180,6 +205,7 @@ extern IntOption opt_temporary_theory_conflicts;
 extern IntOption opt_temporary_theory_reasons;
 extern BoolOption opt_force_directed;
 extern BoolOption opt_decide_graph_chokepoints;
+extern BoolOption opt_graph_csr;
 extern IntOption opt_sort_graph_decisions;
 extern IntOption opt_flow_router_heuristic;
 extern IntOption opt_flow_router_policy;
@@ -218,6 +244,7 @@ extern BoolOption opt_conflict_1uip;
 extern BoolOption opt_use_kt_for_conflicts;
 //extern BoolOption opt_maxflow_backward;
 extern BoolOption opt_conflict_min_cut_maxflow;
+extern IntOption opt_conflict_min_cut_cache;
 extern IntOption opt_history_clear;
 extern BoolOption opt_kt_preserve_order;
 
@@ -234,6 +261,7 @@ extern BoolOption opt_shortest_path_prune_dist;
 extern BoolOption opt_graph_bv_prop;
 
 extern IntOption opt_graph_prop_skip;
+extern IntOption opt_graph_prop_threads;
 extern IntOption opt_bv_prop_skip;
 extern IntOption opt_fsm_prop_skip;
 
@@ -266,7 +294,8 @@ enum class ReachAlg {
     ALG_BFS,
     ALG_RAMAL_REPS,
     ALG_RAMAL_REPS_BATCHED,
-    ALG_RAMAL_REPS_BATCHED2
+    ALG_RAMAL_REPS_BATCHED2,
+    ALG_MULTISOURCE
 };
 
 //For undirected reachability
@@ -294,7 +323,7 @@ enum class MinCutAlg {
 };
 extern MinCutAlg mincutalg;
 enum class MinSpanAlg {
-    ALG_KRUSKAL, ALG_PRIM, ALG_SPIRA_PAN
+    ALG_KRUSKAL, ALG_PRIM, ALG_SPIRA_PAN, ALG_LINK_CUT
 };
 extern MinSpanAlg mstalg;
 enum class ComponentsAlg {
@@ -317,7 +346,7 @@ enum class ConvexHullAlg {
 extern ConvexHullAlg hullAlg;
 
 enum class DistAlg {
-    ALG_SAT, ALG_DIJKSTRA, ALG_DISTANCE, ALG_RAMAL_REPS, ALG_RAMAL_REPS_BATCHED, ALG_RAMAL_REPS_BATCHED2
+    ALG_SAT, ALG_DIJKSTRA, ALG_DISTANCE, ALG_RAMAL_REPS, ALG_RAMAL_REPS_BATCHED, ALG_RAMAL_REPS_BATCHED2, ALG_EVEN_SHILOACH
 };
 
 extern DistAlg distalg;
@@ -0,0 +1,626 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/Portfolio.h"
+#include "monosat/core/Config.h"
+#include "monosat/core/ClauseSharing.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <atomic>
+#include <new>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#if not defined(__MINGW32__)
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace Monosat {
+
+void diversifyPortfolioWorker(SimpSolver& S, int worker){
+    if(worker <= 0)
+        return;
+    //Only search parameters are varied here: the theory solvers (and their choice of algorithms)
+    //were fixed when the constraints were created, and are inherited unchanged by each worker.
+    S.random_seed = opt_random_seed + 7919.0 * worker;
+    S.verbosity = 0;
+    switch(worker % 4){
+        case 1:
+            S.luby_restart = !S.luby_restart;
+            break;
+        case 2:
+            S.rnd_pol = true;
+            S.random_var_freq = 0.01;
+            break;
+        case 3:
+            S.luby_restart = !S.luby_restart;
+            S.phase_saving = 1;
+            break;
+        default:
+            S.random_var_freq = 0.02;
+            break;
+    }
+    S.restart_first = S.restart_first + 25 * (worker % 5);
+}
+
+namespace Cubes {
+struct Candidate {
+    Lit lit;
+    int64_t score;
+};
+
+//Score a splitting literal by the number of literals (including theory atoms, such as reachability or maxflow
+//predicates) that each of its polarities implies. Returns false if the path is refuted; sets 'forced' if only one
+//polarity of l is consistent with the path.
+static bool scoreCandidate(SimpSolver& S, const vec<Lit>& path, Lit l, int64_t& score, Lit& forced){
+    score = -1;
+    forced = lit_Undef;
+    int n_pos = S.lookahead(path, l);
+    if(n_pos == -2)
+        return false;
+    int n_neg = S.lookahead(path, ~l);
+    if(n_neg == -2 || (n_pos == -1 && n_neg == -1))
+        return false;
+    if(n_pos == -1){
+        forced = ~l;
+    }else if(n_neg == -1){
+        forced = l;
+    }else{
+        score = ((int64_t) n_pos + 1) * ((int64_t) n_neg + 1);
+    }
+    return true;
+}
+
+static lbool split(SimpSolver& S, vec<Lit>& path, int n_fixed, const vec<Lit>& candidates, int depth,
+                   vec<vec<Lit>>& cubes){
+    if(S.isInterrupted())
+        return l_Undef;
+    if(S.lookahead(path, lit_Undef) == -2)
+        return l_False;
+    Lit best = lit_Undef;
+    int64_t best_score = -1;
+    if(depth > 0){
+        for(Lit l:candidates){
+            if(S.value(l) != l_Undef)
+                continue;
+            int64_t score;
+            Lit forced;
+            if(!scoreCandidate(S, path, l, score, forced))
+                return l_False;
+            if(forced != lit_Undef){
+                //failed literal: extend this cube without using up any depth
+                path.push(forced);
+                lbool r = split(S, path, n_fixed, candidates, depth, cubes);
+                path.pop();
+                return r;
+            }
+            if(score > best_score){
+                best_score = score;
+                best = l;
+            }
+        }
+    }
+    if(best == lit_Undef){
+        cubes.push();
+        for(int i = n_fixed; i < path.size(); i++)
+            cubes.last().push(path[i]);
+        return l_True;
+    }
+    path.push(best);
+    lbool r_pos = split(S, path, n_fixed, candidates, depth - 1, cubes);
+    path.pop();
+    if(r_pos == l_Undef)
+        return l_Undef;
+    path.push(~best);
+    lbool r_neg = split(S, path, n_fixed, candidates, depth - 1, cubes);
+    path.pop();
+    if(r_neg == l_Undef)
+        return l_Undef;
+    return (r_pos == l_False && r_neg == l_False) ? l_False : l_True;
+}
+}
+
+lbool generateCubes(SimpSolver& S, const vec<Lit>& assume, int depth, vec<vec<Lit>>& cubes){
+    using namespace Cubes;
+    cubes.clear();
+    S.cancelUntil(0);
+    if(!S.okay())
+        return l_False;
+    vec<Lit> splitting_lits;
+    for(Theory* t:S.theories){
+        t->getSplittingLits(splitting_lits);
+    }
+    vec<Lit> path;
+    for(Lit l:assume)
+        path.push(l);
+    if(S.lookahead(path, lit_Undef) == -2){
+        S.cancelUntil(0);
+        return l_False;
+    }
+    //Rank every splitting literal once, below the assumptions, and only consider the best ones deeper in the tree.
+    vec<Candidate> ranked;
+    vec<bool> seen;
+    seen.growTo(S.nVars(), false);
+    for(int i = 0; i < splitting_lits.size() && !S.isInterrupted(); i++){
+        Lit l = splitting_lits[i];
+        if(var(l) >= S.nVars() || seen[var(l)] || S.isEliminated(var(l)) || S.value(l) != l_Undef)
+            continue;
+        seen[var(l)] = true;
+        int64_t score;
+        Lit forced;
+        if(!scoreCandidate(S, path, l, score, forced)){
+            S.cancelUntil(0);
+            return l_False;
+        }
+        if(forced != lit_Undef){
+            path.push(forced);
+        }else{
+            ranked.push({l, score});
+        }
+    }
+    if(S.isInterrupted()){
+        S.cancelUntil(0);
+        return l_Undef;
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const Candidate& a, const Candidate& b){
+        return a.score > b.score;
+    });
+    vec<Lit> candidates;
+    for(int i = 0; i < ranked.size() && i < opt_cube_candidates; i++){
+        candidates.push(ranked[i].lit);
+    }
+    lbool r = split(S, path, assume.size(), candidates, depth, cubes);
+    S.cancelUntil(0);
+    if(opt_verb >= 1){
+        printf("Cubes: %d cubes from %d splitting literals\n", cubes.size(), ranked.size());
+    }
+    return r;
+}
+
+static void writeCubes(SimpSolver& S, const vec<vec<Lit>>& cubes, const char* filename){
+    FILE* f = fopen(filename, "w");
+    if(!f){
+        fprintf(stderr, "Failed to write cubes to file %s\n", filename);
+        return;
+    }
+    for(const vec<Lit>& cube:cubes){
+        fprintf(f, "a");
+        for(Lit l:cube){
+            fprintf(f, " %d", dimacs(S.unmap(l)));
+        }
+        fprintf(f, " 0\n");
+    }
+    fclose(f);
+}
+
+//Record that the instance is UNSAT under 'assume', as established without an unsat core.
+static lbool setUnsat(SimpSolver& S, const vec<Lit>& assume){
+    S.conflict.clear();
+    if(assume.size() == 0 || !S.okay()){
+        S.contradiction();
+    }else{
+        for(Lit l:assume)
+            S.conflict.insert(~l);
+    }
+    return l_False;
+}
+
+//Solve each cube in turn, as assumptions in the same incremental solver.
+static lbool solveCubesSequential(SimpSolver& S, const vec<Lit>& assume, const vec<vec<Lit>>& cubes, bool do_simp){
+    vec<Lit> cube_assume;
+    for(int i = 0; i < cubes.size(); i++){
+        assume.copyTo(cube_assume);
+        for(Lit l:cubes[i])
+            cube_assume.push(l);
+        lbool r = S.solveLimited(cube_assume, i == 0 && opt_pre && do_simp, false);
+        if(r != l_False)
+            return r;
+        else if(!S.okay())
+            return l_False;
+    }
+    return setUnsat(S, assume);
+}
+
+#if not defined(__MINGW32__)
+namespace Portfolio {
+
+//Each worker writes exactly one message to its pipe before exiting:
+//a header of 5 int32 values (result, found_optimal, complete, #model values, #conflict literals),
+//followed by the model (one byte per variable, 0=true, 1=false, 2=undef) and the conflict (as literal indices).
+//A result is 'complete' if it answers the whole query (rather than just the cubes that the worker was assigned).
+struct Message {
+    lbool result = l_Undef;
+    bool found_optimal = false;
+    bool complete = true;
+    std::vector<uint8_t> model;
+    std::vector<int32_t> conflict;
+};
+
+typedef std::function<void(int worker, Message& msg)> WorkerTask;
+
+static bool writeAll(int fd, const void* data, size_t n){
+    const char* buf = (const char*) data;
+    while(n > 0){
+        ssize_t w = write(fd, buf, n);
+        if(w < 0){
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        buf += w;
+        n -= w;
+    }
+    return true;
+}
+
+static bool readAll(int fd, void* data, size_t n){
+    char* buf = (char*) data;
+    while(n > 0){
+        ssize_t r = read(fd, buf, n);
+        if(r < 0){
+            if(errno == EINTR)
+                continue;
+            return false;
+        }else if(r == 0){
+            return false;//worker exited before completing its message
+        }
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+static bool writeMessage(int fd, const Message& msg){
+    int32_t header[5];
+    header[0] = toInt(msg.result);
+    header[1] = msg.found_optimal;
+    header[2] = msg.complete;
+    header[3] = msg.model.size();
+    header[4] = msg.conflict.size();
+    return writeAll(fd, header, sizeof(header)) &&
+           writeAll(fd, msg.model.data(), msg.model.size() * sizeof(uint8_t)) &&
+           writeAll(fd, msg.conflict.data(), msg.conflict.size() * sizeof(int32_t));
+}
+
+static bool readMessage(int fd, Message& msg){
+    int32_t header[5];
+    if(!readAll(fd, header, sizeof(header)))
+        return false;
+    if(header[0] < 0 || header[0] > 2 || header[3] < 0 || header[4] < 0)
+        return false;
+    msg.result = toLbool(header[0]);
+    msg.found_optimal = header[1];
+    msg.complete = header[2];
+    msg.model.resize(header[3]);
+    msg.conflict.resize(header[4]);
+    return readAll(fd, msg.model.data(), msg.model.size() * sizeof(uint8_t)) &&
+           readAll(fd, msg.conflict.data(), msg.conflict.size() * sizeof(int32_t));
+}
+
+static void runWorker(SimpSolver& S, int worker, int fd, ClauseSharing* sharing, const WorkerTask& task){
+#ifdef __linux__
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+    //Interrupts are delivered to the parent, which then kills the workers.
+    signal(SIGINT, SIG_DFL);
+    diversifyPortfolioWorker(S, worker);
+    if(sharing){
+        sharing->attach(worker, S.nVars());
+        S.clause_sharing = sharing;
+    }
+    Message msg;
+    try{
+        task(worker, msg);
+    }catch(...){
+        //Exit without a message; the parent will treat this worker as having failed.
+        fflush(stdout);
+        _exit(1);
+    }
+    if(sharing && opt_verb >= 2){
+        printf("Portfolio worker %d: %" PRId64 " clauses exported, %" PRId64 " imported, %" PRId64 " dropped\n", worker,
+               sharing->stats_exported, sharing->stats_imported, sharing->stats_dropped);
+    }
+    if(msg.result == l_True){
+        msg.model.resize(S.model.size());
+        for(int v = 0; v < S.model.size(); v++){
+            msg.model[v] = S.model[v] == l_True ? 0 : (S.model[v] == l_False ? 1 : 2);
+        }
+    }else if(msg.result == l_False){
+        for(int i = 0; i < S.conflict.size(); i++){
+            msg.conflict.push_back(toInt(S.conflict[i]));
+        }
+    }
+    fflush(stdout);
+    _exit(writeMessage(fd, msg) ? 0 : 1);
+}
+
+//Learnt clauses are only exchanged for plain satisfiability queries: while optimizing, each worker adds
+//its own bounds on the objective, and clauses derived from those bounds do not hold in the other workers.
+static ClauseSharing* createClauseSharing(const vec<Objective>& objectives){
+    if(!opt_share_clauses || objectives.size() > 0)
+        return nullptr;
+    ClauseSharing* sharing = new ClauseSharing(opt_share_buffer_size);
+    if(!sharing->isValid()){
+        delete sharing;
+        return nullptr;
+    }
+    return sharing;
+}
+
+//Fork n_workers copies of this process, each running task(), and wait for the first complete answer.
+//Returns the id of the worker whose answer was accepted (stored in 'winner'), or -1 if there was none.
+static int runWorkers(SimpSolver& S, int n_workers, ClauseSharing* sharing, const WorkerTask& task, Message& winner,
+                      int& n_started, int& n_failed, int& n_incomplete_unsat){
+    S.cancelUntil(0);
+    S.clearInterrupt();
+    fflush(stdout);
+    fflush(stderr);
+
+    std::vector<pid_t> pids;
+    std::vector<int> fds;
+    for(int i = 0; i < n_workers; i++){
+        int p[2];
+        if(pipe(p) != 0){
+            break;
+        }
+        pid_t pid = fork();
+        if(pid == 0){
+            close(p[0]);
+            for(int fd:fds)
+                close(fd);
+            runWorker(S, i, p[1], sharing, task);
+        }
+        close(p[1]);
+        if(pid < 0){
+            close(p[0]);
+            break;
+        }
+        pids.push_back(pid);
+        fds.push_back(p[0]);
+    }
+    n_started = pids.size();
+    n_failed = 0;
+    n_incomplete_unsat = 0;
+    if(opt_verb >= 1){
+        printf("Portfolio: started %d workers\n", n_started);
+        fflush(stdout);
+    }
+
+    int winner_id = -1;
+    std::vector<bool> running(fds.size(), true);
+    int n_running = fds.size();
+    std::vector<struct pollfd> pfds;
+    std::vector<int> pfd_worker;
+    while(n_running > 0 && winner_id < 0 && !S.isInterrupted()){
+        pfds.clear();
+        pfd_worker.clear();
+        for(int i = 0; i < fds.size(); i++){
+            if(running[i]){
+                struct pollfd pfd;
+                pfd.fd = fds[i];
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+                pfds.push_back(pfd);
+                pfd_worker.push_back(i);
+            }
+        }
+        //Wake up periodically to check for interrupts.
+        int n = poll(pfds.data(), pfds.size(), 100);
+        if(n < 0 && errno != EINTR){
+            break;
+        }
+        for(int j = 0; n > 0 && j < pfds.size() && winner_id < 0; j++){
+            if(!pfds[j].revents)
+                continue;
+            int i = pfd_worker[j];
+            running[i] = false;
+            n_running--;
+            Message msg;
+            if(!readMessage(fds[i], msg)){
+                n_failed++;
+            }else if(msg.result != l_Undef && msg.complete){
+                winner_id = i;
+                winner = std::move(msg);
+            }else if(msg.result == l_False){
+                n_incomplete_unsat++;
+            }
+        }
+    }
+
+    for(int i = 0; i < pids.size(); i++){
+        kill(pids[i], SIGKILL);
+    }
+    for(int i = 0; i < pids.size(); i++){
+        while(waitpid(pids[i], nullptr, 0) < 0 && errno == EINTR);
+        close(fds[i]);
+    }
+    if(winner_id >= 0 && opt_verb >= 1){
+        printf("Portfolio: worker %d finished first\n", winner_id);
+    }
+    return winner_id;
+}
+
+//Apply the winning worker's answer to S. Returns l_Undef if a satisfying assignment could not be reproduced.
+static lbool applyAnswer(SimpSolver& S, const Message& winner){
+    if(winner.result == l_False){
+        S.conflict.clear();
+        for(int32_t l:winner.conflict){
+            S.conflict.insert(toLit(l));
+        }
+        if(winner.conflict.empty()){
+            S.contradiction();
+        }
+        return l_False;
+    }
+    //Re-derive the worker's model in S, so that the theory solvers in this process are left in a consistent state.
+    vec<Lit> replay;
+    for(Var v = 0; v < S.nVars() && v < (Var) winner.model.size(); v++){
+        if(S.isEliminated(v) || winner.model[v] == 2)
+            continue;
+        replay.push(mkLit(v, winner.model[v] == 1));
+    }
+    lbool r = S.solveLimited(replay, false, false);
+    if(r != l_True && opt_verb >= 1){
+        printf("Portfolio: failed to replay worker model, solving sequentially\n");
+    }
+    return r == l_True ? l_True : l_Undef;
+}
+}
+
+lbool solveCubes(SimpSolver& S, const vec<Lit>& assume, bool do_simp, int n_workers){
+    using namespace Portfolio;
+    vec<vec<Lit>> cubes;
+    lbool gen = generateCubes(S, assume, opt_cube_depth, cubes);
+    if(gen == l_False){
+        return setUnsat(S, assume);
+    }else if(gen == l_Undef){
+        return l_Undef;
+    }
+    if(strlen(opt_cube_file) > 0){
+        writeCubes(S, cubes, opt_cube_file);
+    }
+    if(n_workers <= 1 || cubes.size() <= 1){
+        return solveCubesSequential(S, assume, cubes, do_simp);
+    }
+    //Workers pull cubes from a counter in shared memory, solving each in their own incremental solver.
+    void* mem = mmap(nullptr, sizeof(std::atomic<int>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(mem == MAP_FAILED){
+        return solveCubesSequential(S, assume, cubes, do_simp);
+    }
+    std::atomic<int>* next_cube = new(mem) std::atomic<int>(0);
+    vec<Objective> no_objectives;
+    ClauseSharing* sharing = createClauseSharing(no_objectives);
+    Message winner;
+    int n_started, n_failed, n_exhausted;
+    int winner_id = runWorkers(S, n_workers, sharing, [&](int worker, Message& msg){
+        vec<Lit> cube_assume;
+        bool first = true;
+        int i;
+        while((i = next_cube->fetch_add(1)) < cubes.size()){
+            assume.copyTo(cube_assume);
+            for(Lit l:cubes[i])
+                cube_assume.push(l);
+            msg.result = S.solveLimited(cube_assume, first && opt_pre && do_simp, false);
+            first = false;
+            if(msg.result != l_False || !S.okay()){
+                return;
+            }
+        }
+        //every cube this worker was assigned is UNSAT
+        msg.result = l_False;
+        msg.complete = false;
+    }, winner, n_started, n_failed, n_exhausted);
+    delete sharing;
+    munmap(mem, sizeof(std::atomic<int>));
+
+    if(winner_id >= 0){
+        lbool r = applyAnswer(S, winner);
+        if(r != l_Undef)
+            return r;
+        return solveCubesSequential(S, assume, cubes, do_simp);
+    }else if(n_started > 0 && n_exhausted == n_started){
+        return setUnsat(S, assume);
+    }else if(n_started > 0 && n_failed == n_started && !S.isInterrupted()){
+        //Every worker failed (e.g., an exception was thrown); re-run in this process to surface the error.
+        return solveCubesSequential(S, assume, cubes, do_simp);
+    }
+    return l_Undef;
+}
+
+lbool solvePortfolio(SimpSolver& S, const vec<Lit>& assume, const vec<Objective>& objectives, bool do_simp,
+                     bool& found_optimal, int n_workers){
+    using namespace Portfolio;
+    if(S.proof){
+        //Only a single, sequential solver can produce a proof
+        return optimize_and_solve(S, assume, objectives, do_simp, found_optimal);
+    }
+    if(opt_cube_depth > 0 && objectives.size() == 0){
+        found_optimal = true;
+        return solveCubes(S, assume, do_simp, n_workers);
+    }
+    if(n_workers <= 1 || !S.okay()){
+        return optimize_and_solve(S, assume, objectives, do_simp, found_optimal);
+    }
+    ClauseSharing* sharing = createClauseSharing(objectives);
+    Message winner;
+    int n_started, n_failed, n_incomplete;
+    int winner_id = runWorkers(S, n_workers, sharing, [&](int worker, Message& msg){
+        msg.result = optimize_and_solve(S, assume, objectives, do_simp, msg.found_optimal);
+    }, winner, n_started, n_failed, n_incomplete);
+    delete sharing;
+
+    if(winner_id < 0){
+        if(n_started > 0 && n_failed == n_started && !S.isInterrupted()){
+            //Every worker failed (e.g., an exception was thrown); re-run in this process to surface the error.
+            return optimize_and_solve(S, assume, objectives, do_simp, found_optimal);
+        }
+        found_optimal = false;
+        return l_Undef;
+    }
+    found_optimal = winner.found_optimal;
+    lbool r = applyAnswer(S, winner);
+    if(r == l_Undef){
+        return optimize_and_solve(S, assume, objectives, do_simp, found_optimal);
+    }
+    return r;
+}
+#else
+
+lbool solveCubes(SimpSolver& S, const vec<Lit>& assume, bool do_simp, int n_workers){
+    vec<vec<Lit>> cubes;
+    lbool gen = generateCubes(S, assume, opt_cube_depth, cubes);
+    if(gen == l_False){
+        return setUnsat(S, assume);
+    }else if(gen == l_Undef){
+        return l_Undef;
+    }
+    if(strlen(opt_cube_file) > 0){
+        writeCubes(S, cubes, opt_cube_file);
+    }
+    return solveCubesSequential(S, assume, cubes, do_simp);
+}
+
+lbool solvePortfolio(SimpSolver& S, const vec<Lit>& assume, const vec<Objective>& objectives, bool do_simp,
+                     bool& found_optimal, int n_workers){
+    if(S.proof){
+        //Only a single, sequential solver can produce a proof
+        return optimize_and_solve(S, assume, objectives, do_simp, found_optimal);
+    }
+    if(opt_cube_depth > 0 && objectives.size() == 0){
+        found_optimal = true;
+        return solveCubes(S, assume, do_simp, n_workers);
+    }
+    return optimize_and_solve(S, assume, objectives, do_simp, found_optimal);
+}
+#endif
+};
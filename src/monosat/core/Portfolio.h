@@ -0,0 +1,58 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PORTFOLIO_H_
+#define PORTFOLIO_H_
+
+#include "monosat/core/Optimize.h"
+#include "monosat/simp/SimpSolver.h"
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+
+namespace Monosat {
+
+//Solve (and optimize) using a portfolio of n_workers diversified copies of S, returning the first answer found.
+//Each worker is a forked copy of this process, so it inherits the complete solver state (including all theory solvers),
+//and the global option/algorithm selections are not shared between workers.
+//The winning answer is replayed in S, so that afterwards S.model, S.conflict, and the theory models are consistent with
+//the answer, exactly as if optimize_and_solve had been called.
+//If -cube-depth is set (and there are no objectives), solves by cube-and-conquer instead (see solveCubes).
+//Falls back to optimize_and_solve if n_workers <= 1, or if fork() is unavailable on this platform.
+//Note: fork() is unsafe if the host process has other running threads that the worker may depend on.
+lbool solvePortfolio(SimpSolver& S, const vec<Lit>& assume, const vec<Objective>& objectives, bool do_simp,
+                     bool& found_optimal, int n_workers);
+
+//Cube-and-conquer: split the search space into cubes using generateCubes(), and then solve each cube
+//(as additional assumptions) in a pool of n_workers incremental solvers, which take cubes from a shared queue.
+//If every cube is refuted, the instance is UNSAT under the assumptions (the conflict then contains all assumptions).
+lbool solveCubes(SimpSolver& S, const vec<Lit>& assume, bool do_simp, int n_workers);
+
+//Split the search space under the given assumptions into at most 2^depth cubes, by lookahead over the splitting
+//literals provided by the theories (graph edge literals). Candidates are scored by the number of literals,
+//including detector atoms, that each polarity implies; failed literals are used to prune and extend cubes.
+//Returns l_False if the assumptions were refuted during lookahead, and l_Undef if interrupted.
+lbool generateCubes(SimpSolver& S, const vec<Lit>& assume, int depth, vec<vec<Lit>>& cubes);
+
+//Apply the search configuration for the given portfolio worker to S.
+//Worker 0 always keeps the unmodified configuration.
+void diversifyPortfolioWorker(SimpSolver& S, int worker);
+};
+#endif /* PORTFOLIO_H_ */
@@ -0,0 +1,179 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/ProofWriter.h"
+#include <cinttypes>
+
+namespace Monosat {
+
+//The premise file starts with a fixed width header, which is filled in once the number of clauses is known.
+static const char* premise_header = "p cnf %12d %12" PRId64 "\n";
+
+bool ProofWriter::AsyncFile::open(const char* filename){
+    file = fopen(filename, "wb");
+    if(!file)
+        return false;
+    fill.reserve(buffer_size + 1024);
+    flushing.reserve(buffer_size + 1024);
+    writer = std::thread(&AsyncFile::run, this);
+    return true;
+}
+
+void ProofWriter::AsyncFile::swap(){
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]{ return !pending; });
+    std::swap(fill, flushing);
+    pending = true;
+    cv.notify_all();
+}
+
+void ProofWriter::AsyncFile::run(){
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        cv.wait(lock, [this]{ return pending || done; });
+        if(pending){
+            //'flushing' is not touched by the solver thread while 'pending' is set
+            lock.unlock();
+            if(flushing.size())
+                fwrite(flushing.data(), 1, flushing.size(), file);
+            flushing.clear();
+            lock.lock();
+            pending = false;
+            cv.notify_all();
+        }else if(done){
+            break;
+        }
+    }
+}
+
+FILE* ProofWriter::AsyncFile::close(bool keep_open){
+    if(!file)
+        return nullptr;
+    swap();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]{ return !pending; });
+        done = true;
+        cv.notify_all();
+    }
+    writer.join();
+    FILE* f = file;
+    file = nullptr;
+    if(keep_open){
+        fflush(f);
+        return f;
+    }
+    fclose(f);
+    return nullptr;
+}
+
+ProofWriter::ProofWriter(const char* proof_file, bool binary, const char* premise_file) : binary(binary),
+                                                                                         has_premises(premise_file &&
+                                                                                                      premise_file[0]){
+    proof.open(proof_file);
+    if(has_premises && premises.open(premise_file)){
+        char header[64];
+        int n = snprintf(header, sizeof(header), premise_header, 0, (int64_t) 0);
+        premises.append(header, n);
+    }
+}
+
+ProofWriter::~ProofWriter(){
+    close();
+}
+
+void ProofWriter::close(){
+    if(closed)
+        return;
+    closed = true;
+    proof.close();
+    FILE* f = premises.close(true);
+    if(f){
+        if(fseek(f, 0, SEEK_SET) == 0){
+            fprintf(f, premise_header, max_var, stats_premises + stats_theory_lemmas);
+        }
+        fclose(f);
+    }
+}
+
+void ProofWriter::writeBinary(char tag, const vec<Lit>& clause){
+    proof.put(tag);
+    for(Lit l:clause){
+        //binary DRAT literals are 2*v+sign, with variables numbered from 1, encoded 7 bits at a time
+        uint64_t u = 2 * ((uint64_t) var(l) + 1) + sign(l);
+        while(u > 127){
+            proof.put((char) (128 | (u & 127)));
+            u >>= 7;
+        }
+        proof.put((char) u);
+    }
+    proof.put(0);
+    proof.checkFull();
+}
+
+void ProofWriter::writeText(AsyncFile& out, const char* prefix, const vec<Lit>& clause){
+    char buf[32];
+    for(const char* s = prefix; *s; s++)
+        out.put(*s);
+    for(Lit l:clause){
+        int n = snprintf(buf, sizeof(buf), "%d ", sign(l) ? -(var(l) + 1) : (var(l) + 1));
+        out.append(buf, n);
+    }
+    out.append("0\n", 2);
+    out.checkFull();
+}
+
+void ProofWriter::write(Step step, const vec<Lit>& clause){
+    if(closed)
+        return;
+    switch(step){
+        case Step::Add:
+            stats_added++;
+            binary ? writeBinary('a', clause) : writeText(proof, "", clause);
+            break;
+        case Step::Delete:
+            stats_deleted++;
+            binary ? writeBinary('d', clause) : writeText(proof, "d ", clause);
+            break;
+        case Step::Premise:
+        case Step::TheoryLemma:
+            if(!has_premises){
+                if(step == Step::TheoryLemma){
+                    stats_theory_lemmas++;
+                    binary ? writeBinary('a', clause) : writeText(proof, "", clause);
+                }
+                break;
+            }
+            for(Lit l:clause){
+                if(var(l) + 1 > max_var)
+                    max_var = var(l) + 1;
+            }
+            if(step == Step::TheoryLemma){
+                stats_theory_lemmas++;
+                writeText(premises, "c theory\n", clause);
+            }else{
+                stats_premises++;
+                writeText(premises, "", clause);
+            }
+            break;
+    }
+}
+};
@@ -0,0 +1,127 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PROOFWRITER_H_
+#define PROOFWRITER_H_
+
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Monosat {
+
+//Streams a DRAT proof (binary or text) to disk.
+//Clauses that the solver did not derive itself - the clauses it was given, and theory lemmas - are not part of the
+//DRAT proof. If a premise file is supplied, they are written there instead, as a DIMACS CNF (with each theory lemma
+//preceded by a 'c theory' comment), so that 'drat-trim <premises> <proof>' checks the propositional reasoning while
+//trusting the theory lemmas, which can be re-verified separately. Without a premise file, theory lemmas are written to
+//the proof as ordinary additions (which a DRAT checker will only accept if they happen to be implied).
+//Literals must already be in the external (DIMACS) numbering.
+//Output is double buffered: a background thread writes one buffer to disk while the solver fills the other.
+class ProofWriter {
+public:
+    enum class Step {
+        Add, Delete, Premise, TheoryLemma
+    };
+
+    ProofWriter(const char* proof_file, bool binary, const char* premise_file = nullptr);
+
+    ~ProofWriter();
+
+    ProofWriter(const ProofWriter&) = delete;
+
+    ProofWriter& operator=(const ProofWriter&) = delete;
+
+    bool isValid() const{
+        return proof.isOpen() && (!has_premises || premises.isOpen());
+    }
+
+    void write(Step step, const vec<Lit>& clause);
+
+    //Flush all buffered output and close the files. Called by the destructor.
+    void close();
+
+    int64_t stats_added = 0;
+    int64_t stats_deleted = 0;
+    int64_t stats_premises = 0;
+    int64_t stats_theory_lemmas = 0;
+private:
+    class AsyncFile {
+    public:
+        static const size_t buffer_size = 1 << 20;
+
+        bool open(const char* filename);
+
+        bool isOpen() const{
+            return file != nullptr;
+        }
+
+        inline void put(char c){
+            fill.push_back(c);
+        }
+
+        void append(const char* s, size_t n){
+            fill.insert(fill.end(), s, s + n);
+        }
+
+        //Hand the buffer over to the writer thread, if it is full.
+        inline void checkFull(){
+            if(fill.size() >= buffer_size)
+                swap();
+        }
+
+        //Flush and close the file; returns the (still open) FILE* if 'keep_open' is set, so that a header can be
+        //rewritten after all output is on disk.
+        FILE* close(bool keep_open = false);
+
+    private:
+        void swap();
+
+        void run();
+
+        FILE* file = nullptr;
+        std::vector<char> fill;
+        std::vector<char> flushing;
+        std::thread writer;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool pending = false;
+        bool done = false;
+    };
+
+    void writeBinary(char tag, const vec<Lit>& clause);
+
+    void writeText(AsyncFile& out, const char* prefix, const vec<Lit>& clause);
+
+    AsyncFile proof;
+    AsyncFile premises;
+    bool binary;
+    bool has_premises;
+    bool closed = false;
+    int max_var = 0;
+};
+};
+#endif /* PROOFWRITER_H_ */
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include "monosat/mtl/Sort.h"
 #include "monosat/graph/GraphTheory.h"
+#include "monosat/core/ClauseSharing.h"
 #include <ctype.h>
 
 using namespace Monosat;
@@ -63,7 +64,7 @@ Solver::Solver() :
         0), stats_pure_theory_lits(0), pure_literal_detections(0), stats_removed_clauses(0), dec_vars(0),
         clauses_literals(
                 0), learnts_literals(0), max_literals(0), tot_literals(0), stats_pure_lit_time(0), ok(
-        true), cla_inc(1), var_inc(1), theory_inc(1), watches(WatcherDeleted(ca)), qhead(0), simpDB_assigns(-1),
+        true), cla_inc(1), var_inc(1), theory_inc(1), watches(WatcherDeleted(ca)), watches_bin(WatcherDeleted(ca)), qhead(0), simpDB_assigns(-1),
         simpDB_props(
                 0), order_heap(VarOrderLt(activity, priority)), theory_order_heap(HeuristicOrderLt(), HeuristicToInt()),
         progress_estimate(0), remove_satisfied(true) //lazy_heap( LazyLevelLt(this)),
@@ -83,6 +84,7 @@ Solver::~Solver(){
         delete (t);
     }
     delete pbsolver;
+    delete proof;
 }
 
 const std::string Solver::empty_name = "";
@@ -107,11 +109,15 @@ Var Solver::newVar(bool sign, bool dvar){
         activity.push();
         seen.push(0);
         polarity.push();
+        target_phase.push();
+        best_phase.push();
         decision.push();
         trail.capacity(v + 1);
     }
     watches.init(mkLit(v, false));
     watches.init(mkLit(v, true));
+    watches_bin.init(mkLit(v, false));
+    watches_bin.init(mkLit(v, true));
     assigns[v] = l_Undef;
     vardata[v] = mkVarData(CRef_Undef, 0);
     int p = 0;
@@ -125,6 +131,8 @@ Var Solver::newVar(bool sign, bool dvar){
     activity[v] = (rnd_init_act ? drand(random_seed) * 0.00001 : 0);
     seen[v] = 0;
     polarity[v] = opt_init_rnd_phase ? irand(random_seed, 1) : sign;
+    target_phase[v] = l_Undef;
+    best_phase[v] = l_Undef;
     //decision.push();//set below
 
     if(max_decision_var > 0 && v > max_decision_var)
@@ -179,6 +187,9 @@ bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause){
             resetInitialPropagation();    //Ensure that super solver call propagate on this solver at least once.
         }
     }
+    //derived clauses have already been logged by the caller
+    if(proof && !is_derived_clause && !adding_derived_clauses)
+        logProof(ProofWriter::Step::Premise, ps);
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p;
@@ -188,7 +199,12 @@ bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause){
             return true;
         else if(value(ps[i]) != l_False && ps[i] != p)
             ps[j++] = p = ps[i];
-    ps.shrink(i - j);
+    if(proof && i != j){
+        ps.shrink(i - j);
+        logProof(ProofWriter::Step::Add, ps);
+    }else{
+        ps.shrink(i - j);
+    }
     checkClause(ps);
     if(ps.size() == 0)
         return ok = false;
@@ -220,6 +236,7 @@ CRef Solver::attachReasonClause(Lit r, vec<Lit>& ps){
         fprintf(opt_write_learnt_clauses, " 0\n");
         fflush(opt_write_learnt_clauses);
     }
+    logProof(ProofWriter::Step::TheoryLemma, ps);
 
     //sort(ps);
     Lit p;
@@ -230,6 +247,8 @@ CRef Solver::attachReasonClause(Lit r, vec<Lit>& ps){
         else if((value(ps[i]) != l_False || level(var(ps[i])) != 0) && ps[i] != p)
             ps[j++] = p = ps[i];
     ps.shrink(i - j);
+    if(proof && i != j)
+        logProof(ProofWriter::Step::Add, ps);
 
     CRef confl_out = CRef_Undef;
     if(ps.size() == 0){
@@ -328,8 +347,9 @@ void Solver::attachClause(CRef cr){
             }
         }
 #endif
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>& ws = c.size() == 2 ? watches_bin : watches;
+    ws[~c[0]].push(Watcher(cr, c[1]));
+    ws[~c[1]].push(Watcher(cr, c[0]));
     if(c.learnt())
         learnts_literals += c.size();
     else
@@ -339,14 +359,14 @@ void Solver::attachClause(CRef cr){
 void Solver::detachClause(CRef cr, bool strict){
     const Clause& c = ca[cr];
     assert(c.size() > 1);
-
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>& ws = c.size() == 2 ? watches_bin : watches;
     if(strict){
-        remove(watches[~c[0]], Watcher(cr, c[1]));
-        remove(watches[~c[1]], Watcher(cr, c[0]));
+        remove(ws[~c[0]], Watcher(cr, c[1]));
+        remove(ws[~c[1]], Watcher(cr, c[0]));
     }else{
         // Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-        watches.smudge(~c[0]);
-        watches.smudge(~c[1]);
+        ws.smudge(~c[0]);
+        ws.smudge(~c[1]);
     }
 
     if(c.learnt())
@@ -358,10 +378,14 @@ void Solver::detachClause(CRef cr, bool strict){
 void Solver::removeClause(CRef cr){
     CRef remove_clause = cr;
     Clause& c = ca[cr];
+    logProof(ProofWriter::Step::Delete, c);
     detachClause(cr);
     // Don't leave pointers to free'd memory!
-    if(locked(c))
+    if(locked(c)){
+        if(c.size() == 2 && !(value(c[0]) == l_True && reason(var(c[0])) == cr))
+            std::swap(c[0], c[1]);
         vardata[var(c[0])].reason = CRef_Undef;
+    }
     c.mark(1);
     ca.free(cr);
 }
@@ -594,7 +618,61 @@ Lit Solver::pickBranchLit(){
         }else
             next = order_heap.removeMin();
 
-    return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : polarity[next]);
+    return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : decisionPolarity(next));
+}
+
+void Solver::updateTargetPhases(){
+    //All assignments made before the last decision are conflict free.
+    int n_assigned = trail_lim.size() ? trail_lim.last() : trail.size();
+    if(n_assigned > target_assigned){
+        for(int i = 0; i < n_assigned; i++){
+            target_phase[var(trail[i])] = lbool(sign(trail[i]));
+        }
+        target_assigned = n_assigned;
+    }
+    if(n_assigned > best_assigned){
+        for(int i = 0; i < n_assigned; i++){
+            best_phase[var(trail[i])] = lbool(sign(trail[i]));
+        }
+        best_assigned = n_assigned;
+    }
+}
+
+void Solver::rephase(){
+    //Cycle through best, inverted, best, random phases (the best phase is reset after it is used, so that a
+    //new best phase can be found from the new starting point).
+    int type = rephase_count % 4;
+    rephase_count++;
+    for(Var v = 0; v < nVars(); v++){
+        if(type == 1){
+            polarity[v] = !polarity[v];
+        }else if(type == 3){
+            polarity[v] = irand(random_seed, 1);
+        }else if(best_phase[v] != l_Undef){
+            polarity[v] = best_phase[v] == l_True;
+        }
+        target_phase[v] = l_Undef;
+    }
+    if(type == 0 || type == 2){
+        best_assigned = 0;
+    }
+    target_assigned = 0;
+    next_rephase = conflicts + (uint64_t) opt_rephase_interval * (rephase_count + 1);
+}
+
+void Solver::switchMode(){
+    stable_mode = !stable_mode;
+    mode_switches++;
+    //Each focused phase is followed by a stable phase of the same length; the length doubles after each pair.
+    uint64_t length = (uint64_t) opt_mode_switch << std::min(mode_switches / 2, 20);
+    next_mode_switch = conflicts + length;
+    target_assigned = 0;
+    if(stable_mode && opt_rephase_interval > 0 && next_rephase == 0){
+        next_rephase = conflicts + opt_rephase_interval;
+    }
+    if(opt_verb >= 2){
+        printf("Switching to %s mode at %" PRIu64 " conflicts\n", stable_mode ? "stable" : "focused", conflicts);
+    }
 }
 
 void Solver::instantiateLazyDecision(Lit p, int atLevel, CRef reason){
@@ -642,6 +720,8 @@ void Solver::analyzeHeuristicDecisions(CRef confl, IntSet<int>& conflicting_heur
         if(confl != CRef_Undef){
             assert(!isTheoryCause(confl));
             Clause& c = ca[confl];
+            if(p != lit_Undef)
+                orderBinaryReason(c, var(p));
 
             for(int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
                 Lit q = c[j];
@@ -787,9 +867,18 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel){
         if(confl != CRef_Undef){
             assert(!isTheoryCause(confl));
             Clause& c = ca[confl];
+            if(p != lit_Undef)
+                orderBinaryReason(c, var(p));
 
-            if(c.learnt())
+            if(c.learnt()){
                 claBumpActivity(c);
+                c.lastUsed() = (uint32_t) conflicts;
+                if(c.lbd() > (uint32_t) opt_lbd_core){
+                    uint32_t lbd = computeLBD(c);
+                    if(lbd < c.lbd())
+                        c.lbd() = lbd;
+                }
+            }
 
             for(int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
                 Lit q = c[j];
@@ -887,6 +976,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel){
                 out_learnt[j++] = out_learnt[i];
             else{
                 Clause& c = ca[reason(var(out_learnt[i]))];
+                orderBinaryReason(c, var(out_learnt[i]));
                 for(int k = 1; k < c.size(); k++)
                     if(!seen[var(c[k])] && level(var(c[k])) > 0){
                         out_learnt[j++] = out_learnt[i];
@@ -949,6 +1039,7 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels){
         }
 
         Clause& c = ca[reason(var(analyze_stack.last()))];
+        orderBinaryReason(c, var(analyze_stack.last()));
         analyze_stack.pop();
 
         for(int i = 1; i < c.size(); i++){
@@ -1005,6 +1096,7 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict){
                 }else{
 
                     Clause& c = ca[reason(x)];
+                    orderBinaryReason(c, x);
                     assert(var(c[0]) == x);
                     for(int j = 1; j < c.size(); j++)
                         if(level(var(c[j])) > 0)
@@ -1294,6 +1386,106 @@ void Solver::enqueueAnyUnqueued(){
 }
 
 
+/*_________________________________________________________________________________________________
+ |
+ |  propagateClauses : (int& num_props)  ->  [Clause*]
+ |
+ |  Description:
+ |    Unit propagation over the clause database only (no theories): propagates all enqueued facts
+ |    from qhead onward. If a conflict arises, the conflicting clause is returned (and qhead is moved
+ |    to the end of the trail), otherwise CRef_Undef. 'num_props' is incremented once per propagated
+ |    literal.
+ |________________________________________________________________________________________________@*/
+CRef Solver::propagateClauses(int& num_props){
+    CRef confl = CRef_Undef;
+    while(qhead < trail.size()){
+        Lit p = trail[qhead++];     // 'p' is enqueued fact to propagate.
+        num_props++;
+
+        // Binary clauses: the other literal is stored in the watcher, so the clause itself is never read.
+        // (Consequently, the implied literal of a binary reason clause may be either of its two literals.)
+        const vec<Watcher>& wbin = watches_bin[p];
+        for(int k = 0; k < wbin.size(); k++){
+            Lit imp = wbin[k].blocker;
+            if(value(imp) == l_Undef){
+                uncheckedEnqueue(imp, wbin[k].cref);
+            }else if(value(imp) == l_False){
+                confl = wbin[k].cref;
+                break;
+            }
+        }
+        if(confl != CRef_Undef){
+            qhead = trail.size();
+            break;
+        }
+
+        vec<Watcher>& ws = watches[p];
+        Watcher* i, * j, * end;
+        Lit false_lit = ~p;
+        for(i = j = (Watcher*) ws, end = i + ws.size(); i != end;){
+            // Try to avoid inspecting the clause:
+            Lit blocker = i->blocker;
+            if(value(blocker) == l_True){
+                *j++ = *i++;
+                continue;
+            }
+
+            // Start loading the next clause that will (probably) need to be inspected, while this one is processed:
+            if(i + 1 != end && value(i[1].blocker) != l_True)
+                prefetchClause(i[1].cref);
+
+            // Make sure the false literal is data[1]:
+            CRef cr = i->cref;
+            Clause& c = ca[cr];
+            if(c[0] == false_lit)
+                c[0] = c[1], c[1] = false_lit;
+            assert(c[1] == false_lit);
+            i++;
+
+            // If 0th watch is true, then clause is already satisfied.
+            Lit first = c[0];
+            Watcher w = Watcher(cr, first);
+            if(first != blocker && value(first) == l_True){
+                *j++ = w;
+                continue;
+            }
+
+            // Look for new watch (ternary clauses have exactly one candidate):
+            if(c.size() == 3){
+                if(value(c[2]) != l_False){
+                    c[1] = c[2];
+                    c[2] = false_lit;
+                    watches[~c[1]].push(w);
+                    goto NextClause;
+                }
+            }else{
+                for(int k = 2; k < c.size(); k++)
+                    if(value(c[k]) != l_False){
+                        c[1] = c[k];
+                        c[k] = false_lit;
+                        watches[~c[1]].push(w);
+                        goto NextClause;
+                    }
+            }
+
+            // Did not find watch -- clause is unit under assignment:
+            *j++ = w;
+            if(value(first) == l_False){
+                confl = cr;
+                qhead = trail.size();
+                // Copy the remaining watches:
+                while(i < end)
+                    *j++ = *i++;
+            }else
+                uncheckedEnqueue(first, cr);
+
+            NextClause:;
+        }
+        ws.shrink(i - j);
+    }
+    return confl;
+}
+
 /*_________________________________________________________________________________________________
  |
  |  propagate : [void]  ->  [Clause*]
@@ -1316,66 +1508,14 @@ CRef Solver::propagate(bool propagate_theories){
     int num_props = 0;
     int initial_qhead = qhead;
     watches.cleanAll();
+    watches_bin.cleanAll();
     if(decisionLevel() == 0 && !propagate_theories){
         initialPropagate = true;//we will need to propagate this assignment to the theories at some point in the future.
     }
     do{
-
-        while(qhead < trail.size()){
-            Lit p = trail[qhead++];     // 'p' is enqueued fact to propagate.
-
-            vec<Watcher>& ws = watches[p];
-            Watcher* i, * j, * end;
-            num_props++;
-            for(i = j = (Watcher*) ws, end = i + ws.size(); i != end;){
-                // Try to avoid inspecting the clause:
-                Lit blocker = i->blocker;
-                if(value(blocker) == l_True){
-                    *j++ = *i++;
-                    continue;
-                }
-
-                // Make sure the false literal is data[1]:
-                CRef cr = i->cref;
-                Clause& c = ca[cr];
-                Lit false_lit = ~p;
-                if(c[0] == false_lit)
-                    c[0] = c[1], c[1] = false_lit;
-                assert(c[1] == false_lit);
-                i++;
-
-                // If 0th watch is true, then clause is already satisfied.
-                Lit first = c[0];
-                Watcher w = Watcher(cr, first);
-                if(first != blocker && value(first) == l_True){
-                    *j++ = w;
-                    continue;
-                }
-
-                // Look for new watch:
-                for(int k = 2; k < c.size(); k++)
-                    if(value(c[k]) != l_False){
-                        c[1] = c[k];
-                        c[k] = false_lit;
-                        watches[~c[1]].push(w);
-                        goto NextClause;
-                    }
-
-                // Did not find watch -- clause is unit under assignment:
-                *j++ = w;
-                if(value(first) == l_False){
-                    confl = cr;
-                    qhead = trail.size();
-                    // Copy the remaining watches:
-                    while(i < end)
-                        *j++ = *i++;
-                }else
-                    uncheckedEnqueue(first, cr);
-
-                NextClause:;
-            }
-            ws.shrink(i - j);
-        }
+        //Boolean propagation runs to a fixed point before any theory is propagated; literals enqueued by the theories
+        //are picked up by the next round of this loop.
+        confl = propagateClauses(num_props);
 
         if(initialPropagate && decisionLevel() == 0 && propagate_theories){
             assert(decisionLevel() == 0);
@@ -1500,6 +1640,42 @@ struct reduceDB_lt {
 void Solver::reduceDB(){
     int i, j;
     double extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
+    if(opt_lbd_tiers){
+        //Core clauses (low LBD) are always kept; tier2 clauses and theory lemmas are kept as long as they are still
+        //being used in conflict analysis. Everything else (the local tier) competes on activity, as below.
+        uint32_t now = (uint32_t) conflicts;
+        vec<CRef>& local = reduce_local;
+        local.clear();
+        n_tiered_learnts = 0;
+        for(i = j = 0; i < learnts.size(); i++){
+            Clause& c = ca[learnts[i]];
+            bool keep = c.size() <= 2 || locked(c) || c.lbd() <= (uint32_t) opt_lbd_core;
+            if(!keep && c.derivedClause())
+                keep = now - c.lastUsed() < (uint32_t) opt_theory_lemma_unused;
+            else if(!keep && c.lbd() <= (uint32_t) opt_lbd_tier2)
+                keep = now - c.lastUsed() < (uint32_t) opt_tier2_unused;
+            if(keep){
+                learnts[j++] = learnts[i];
+                n_tiered_learnts++;
+            }else
+                local.push(learnts[i]);
+        }
+        learnts.shrink(i - j);
+
+        sort(local, reduceDB_lt(ca));
+        for(i = 0; i < local.size(); i++){
+            Clause& c = ca[local[i]];
+            if(i < local.size() / 2 || c.activity() < extra_lim){
+                stats_removed_clauses++;
+                if(c.derivedClause())
+                    stats_removed_theory_lemmas++;
+                removeClause(local[i]);
+            }else
+                learnts.push(local[i]);
+        }
+        checkGarbage();
+        return;
+    }
 
     sort(learnts, reduceDB_lt(ca));
     // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
@@ -1516,6 +1692,266 @@ void Solver::reduceDB(){
     checkGarbage();
 }
 
+void Solver::exportLearntClause(const vec<Lit>& c, int lbd){
+    if(!clause_sharing || c.size() > opt_share_max_size)
+        return;
+    //only share clauses with a small literal block distance (number of distinct decision levels)
+    if(c.size() > 2 && lbd > opt_share_max_lbd)
+        return;
+    clause_sharing->exportClause(c);
+}
+
+bool Solver::importSharedClauses(){
+    assert(decisionLevel() == 0);
+    while(ok && clause_sharing->importClause(shared_clause)){
+        int i, j;
+        bool skip = false;
+        for(i = j = 0; i < shared_clause.size(); i++){
+            Lit l = shared_clause[i];
+            if(var(l) >= nVars() || isEliminated(var(l)) || value(l) == l_True){
+                skip = true;
+                break;
+            }else if(value(l) != l_False){
+                shared_clause[j++] = l;
+            }
+        }
+        if(skip)
+            continue;
+        shared_clause.shrink(i - j);
+        if(shared_clause.size() == 0){
+            ok = false;
+        }else if(shared_clause.size() == 1){
+            uncheckedEnqueue(shared_clause[0]);
+        }else{
+            CRef cr = ca.alloc(shared_clause, true);
+            ca[cr].lbd() = shared_clause.size();
+            ca[cr].lastUsed() = (uint32_t) conflicts;
+            learnts.push(cr);
+            attachClause(cr);
+        }
+    }
+    return ok;
+}
+
+bool Solver::inprocess(){
+    assert(decisionLevel() == 0);
+    inprocess_rounds++;
+    if(!simplify())
+        return false;
+    subsumeLearnts();
+    if(!vivifyLearnts())
+        return false;
+    checkGarbage();
+    return ok;
+}
+
+struct subsume_lt {
+    ClauseAllocator& ca;
+
+    subsume_lt(ClauseAllocator& ca) : ca(ca){}
+
+    bool operator()(CRef x, CRef y){
+        return ca[x].size() < ca[y].size();
+    }
+};
+
+void Solver::subsumeLearnts(){
+    assert(decisionLevel() == 0);
+    //Only learnt clauses are candidates for removal, but both learnt and original clauses can subsume them.
+    vec<vec<int>> occs;
+    occs.growTo(2 * nVars());
+    for(int i = 0; i < learnts.size(); i++){
+        const Clause& c = ca[learnts[i]];
+        for(int k = 0; k < c.size(); k++)
+            occs[toInt(c[k])].push(i);
+    }
+    vec<CRef> subsumers;
+    for(CRef cr:learnts)
+        subsumers.push(cr);
+    for(CRef cr:clauses){
+        if(!ca[cr].mark())
+            subsumers.push(cr);
+    }
+    sort(subsumers, subsume_lt(ca));
+
+    vec<char> lit_seen;
+    lit_seen.growTo(2 * nVars(), 0);
+    int64_t budget = 10 * (int64_t) learnts_literals + 1000000;
+    for(int n = 0; n < subsumers.size() && budget > 0 && !asynch_interrupt; n++){
+        Clause& d = ca[subsumers[n]];
+        if(d.mark())
+            continue;
+        //only clauses containing the least frequent literal of 'd' can be subsumed by it
+        Lit best = d[0];
+        for(int k = 0; k < d.size(); k++){
+            lit_seen[toInt(d[k])] = 1;
+            if(occs[toInt(d[k])].size() < occs[toInt(best)].size())
+                best = d[k];
+        }
+        for(int i:occs[toInt(best)]){
+            CRef cr = learnts[i];
+            Clause& c = ca[cr];
+            if(cr == subsumers[n] || c.mark() || c.size() < d.size())
+                continue;
+            budget -= c.size();
+            int n_shared = 0;
+            for(int k = 0; k < c.size(); k++)
+                n_shared += lit_seen[toInt(c[k])];
+            if(n_shared == d.size() && !locked(c)){
+                if(d.learnt() && d.activity() < c.activity())
+                    d.activity() = c.activity();
+                stats_subsumed_learnts++;
+                removeClause(cr);
+            }
+        }
+        for(int k = 0; k < d.size(); k++)
+            lit_seen[toInt(d[k])] = 0;
+    }
+
+    int i, j;
+    for(i = j = 0; i < learnts.size(); i++){
+        if(!ca[learnts[i]].mark())
+            learnts[j++] = learnts[i];
+    }
+    learnts.shrink(i - j);
+}
+
+struct vivify_lt {
+    ClauseAllocator& ca;
+    const vec<CRef>& learnts;
+
+    vivify_lt(ClauseAllocator& ca, const vec<CRef>& learnts) : ca(ca), learnts(learnts){}
+
+    bool operator()(int x, int y){
+        return ca[learnts[x]].activity() > ca[learnts[y]].activity();
+    }
+};
+
+bool Solver::vivifyLearnts(){
+    assert(decisionLevel() == 0);
+    //vivify the most active learnt clauses first
+    vec<int> candidates;
+    for(int i = 0; i < learnts.size(); i++){
+        const Clause& c = ca[learnts[i]];
+        if(c.size() > 2 && !locked(c))
+            candidates.push(i);
+    }
+    sort(candidates, vivify_lt(ca, learnts));
+    if(candidates.size() > opt_vivify_max)
+        candidates.shrink(candidates.size() - opt_vivify_max);
+
+    vec<Lit> original;
+    vec<Lit> shortened;
+    vec<Lit> removed;
+    for(int idx:candidates){
+        if(!ok || asynch_interrupt)
+            break;
+        CRef cr = learnts[idx];
+        Clause& c = ca[cr];
+        if(satisfied(c))
+            continue;
+        original.clear();
+        for(int k = 0; k < c.size(); k++){
+            if(value(c[k]) != l_False)
+                original.push(c[k]);
+        }
+        float act = c.activity();
+        uint32_t lbd = c.lbd();
+        uint32_t last_used = c.lastUsed();
+        bool derived = c.derivedClause();
+        //the clause must not take part in its own propagation
+        //(but in the proof, it can only be deleted once its replacement has been added)
+        ProofWriter* deferred_proof = proof;
+        if(proof){
+            removed.clear();
+            for(Lit l:c)
+                removed.push(l);
+        }
+        proof = nullptr;
+        removeClause(cr);
+        proof = deferred_proof;
+
+        //assign the negation of each literal in turn; literals that become false are redundant,
+        //and the clause can be cut short as soon as a literal becomes true or a conflict is found.
+        shortened.clear();
+        bool aborted = false;
+        for(int k = 0; k < original.size(); k++){
+            Lit l = original[k];
+            if(value(l) == l_True){
+                shortened.push(l);
+                break;
+            }else if(value(l) == l_Undef){
+                shortened.push(l);
+                if(k == original.size() - 1)
+                    break;
+                int lev = decisionLevel();
+                newDecisionLevel();
+                uncheckedEnqueue(~l);
+                //theory propagations have no reason clauses, so the shortened clause would not be RUP in the proof
+                CRef confl = propagate(proof == nullptr);
+                if(!ok || decisionLevel() != lev + 1){
+                    //a theory lemma caused a backjump; keep the clause as it was
+                    aborted = true;
+                    break;
+                }else if(confl != CRef_Undef){
+                    break;
+                }
+            }
+        }
+        cancelUntil(0);
+        if(!ok)
+            return false;
+
+        vec<Lit>& out = aborted ? original : shortened;
+        if(out.size() < original.size()){
+            stats_vivified_clauses++;
+            stats_vivified_lits += original.size() - out.size();
+        }
+        //a backjumping theory lemma may have added new facts at level 0
+        bool sat = false;
+        int i, j;
+        for(i = j = 0; i < out.size() && !sat; i++){
+            sat = value(out[i]) == l_True;
+            if(value(out[i]) == l_Undef)
+                out[j++] = out[i];
+        }
+        out.shrink(i - j);
+        if(proof){
+            if(!sat)
+                logProof(ProofWriter::Step::Add, out);
+            logProof(ProofWriter::Step::Delete, removed);
+        }
+        if(sat){
+            learnts[idx] = CRef_Undef;
+        }else if(out.size() == 0){
+            return ok = false;
+        }else if(out.size() == 1){
+            learnts[idx] = CRef_Undef;
+            uncheckedEnqueue(out[0]);
+            if(propagate(true) != CRef_Undef)
+                return ok = false;
+        }else{
+            CRef nr = ca.alloc(out, true);
+            ca[nr].activity() = act;
+            ca[nr].lbd() = std::min(lbd, (uint32_t) out.size());
+            ca[nr].lastUsed() = last_used;
+            ca[nr].setDerived(derived);
+            learnts[idx] = nr;
+            attachClause(nr);
+        }
+        if(aborted)
+            break;
+    }
+
+    int i, j;
+    for(i = j = 0; i < learnts.size(); i++){
+        if(learnts[i] != CRef_Undef)
+            learnts[j++] = learnts[i];
+    }
+    learnts.shrink(i - j);
+    return ok;
+}
+
 void Solver::removeSatisfied(vec<CRef>& cs){
     int i, j;
     for(i = j = 0; i < cs.size(); i++){
@@ -1735,6 +2171,7 @@ void Solver::addClauseSafely(vec<Lit>& ps){
         fprintf(opt_write_learnt_clauses, " 0\n");
         fflush(opt_write_learnt_clauses);
     }
+    logProof(ProofWriter::Step::TheoryLemma, ps);
 
     if(decisionLevel() == 0){
         addClause_(ps, true);
@@ -1761,6 +2198,8 @@ void Solver::addClauseSafely(vec<Lit>& ps){
             }
         }
         ps.shrink(i - j);
+        if(proof && i != j)
+            logProof(ProofWriter::Step::Add, ps);
         if(false_count == ps.size() - 1){
             //this clause is unit under the current assignment.
             //although we _could_ wait until a restart to add this clause, in many cases this will lead to very poor solver behaviour.
@@ -1842,6 +2281,7 @@ bool Solver::addConflictClause(vec<Lit>& ps, CRef& confl_out, bool permanent){
         fprintf(opt_write_learnt_clauses, " 0\n");
         fflush(opt_write_learnt_clauses);
     }
+    logProof(ProofWriter::Step::TheoryLemma, ps);
 
     sort(ps);
     Lit p;
@@ -1856,7 +2296,12 @@ bool Solver::addConflictClause(vec<Lit>& ps, CRef& confl_out, bool permanent){
 
     }
     ps.shrink(i - j);
+    if(proof && i != j)
+        logProof(ProofWriter::Step::Add, ps);
     confl_out = CRef_Undef;
+    if(clause_sharing && (ps.size() <= 2 || (permanent && ps.size() <= opt_share_max_size))){
+        clause_sharing->exportClause(ps);
+    }
     if(ps.size() == 0){
         ok = false;
         cancelUntil(0);
@@ -1954,6 +2399,8 @@ bool Solver::addConflictClause(vec<Lit>& ps, CRef& confl_out, bool permanent){
             if(permanent || opt_permanent_theory_conflicts)
                 clauses.push(cr);
             else{
+                ca[cr].lbd() = computeLBD(ps);
+                ca[cr].lastUsed() = (uint32_t) conflicts;
                 learnts.push(cr);
                 if(--learntsize_adjust_cnt <= 0){
                     learntsize_adjust_confl *= learntsize_adjust_inc;
@@ -1990,6 +2437,19 @@ bool Solver::addConflictClause(vec<Lit>& ps, CRef& confl_out, bool permanent){
     return true;
 }
 
+void Solver::logLevelZeroTheoryReasons(){
+    //Learnt clauses omit literals that are false at level 0, so the theory lemmas implying those literals must be in
+    //the proof too. Theory reasons are otherwise only constructed (and logged) on demand, during conflict analysis.
+    int end = trail_lim.size() ? trail_lim[0] : trail.size();
+    if(proof_trail_head > end)
+        proof_trail_head = end;
+    for(; proof_trail_head < end; proof_trail_head++){
+        Lit p = trail[proof_trail_head];
+        if(isTheoryCause(reason(var(p))))
+            constructReason(p);
+    }
+}
+
 bool Solver::addDelayedClauses(CRef& conflict_out){
     conflict_out = CRef_Undef;
     while(clauses_to_add.size() && ok){
@@ -2074,6 +2534,8 @@ lbool Solver::search(int nof_conflicts){
             }
             if(decisionLevel() == 0)
                 return l_False;
+            if(stable_mode)
+                updateTargetPhases();
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
 
@@ -2270,6 +2732,17 @@ lbool Solver::search(int nof_conflicts){
                 }
             }
 
+            //Chronological backtracking: rather than discarding a long stretch of the trail (and the theory solvers'
+            //state along with it), only undo the conflict level, and assert the learnt literal out of order, at its
+            //(lower) assertion level. cancelUntil() and analyze() already handle literals with out-of-order levels.
+            //Theory solvers expect to receive their literals in level order, so theory atoms are always asserted
+            //after a regular backjump.
+            int assert_level = backtrack_level;
+            if(opt_chrono_backtrack >= 0 && !S && learnt_clause.size() > 1 && !order_changed &&
+               !hasTheory(learnt_clause[0]) && decisionLevel() - backtrack_level > opt_chrono_backtrack){
+                backtrack_level = decisionLevel() - 1;
+                stats_chrono_backtracks++;
+            }
             cancelUntil(backtrack_level);
 
             if(opt_theory_order_swapping && order_changed){
@@ -2280,17 +2753,33 @@ lbool Solver::search(int nof_conflicts){
 
             //this is now slightly more complicated, if there are multiple lits implied by the super solver in the current decision level:
             //The learnt clause may not be asserting.
-
+            int lbd = computeLBD(learnt_clause);
+            if(proof){
+                logLevelZeroTheoryReasons();
+                logProof(ProofWriter::Step::Add, learnt_clause);
+            }
+            exportLearntClause(learnt_clause, lbd);
+            if(opt_mode_switch){
+                //Bias-corrected exponential moving averages of the learnt clause LBDs, for focused mode restarts
+                double n = (double) conflicts;
+                lbd_ema_fast += (lbd - lbd_ema_fast) * std::max(1.0 / 32, 1.0 / n);
+                lbd_ema_slow += (lbd - lbd_ema_slow) * std::max(1.0 / 4096, 1.0 / n);
+            }
             if(learnt_clause.size() == 1){
                 uncheckedEnqueue(learnt_clause[0]);
             }else{
                 CRef cr = ca.alloc(learnt_clause, true);
+                ca[cr].lbd() = lbd;
+                ca[cr].lastUsed() = (uint32_t) conflicts;
                 learnts.push(cr);
                 attachClause(cr);
                 claBumpActivity(ca[cr]);
 
                 if(value(learnt_clause[0]) == l_Undef){
-                    uncheckedEnqueue(learnt_clause[0], cr);
+                    if(assert_level < decisionLevel())
+                        enqueueLazy(learnt_clause[0], assert_level, cr);
+                    else
+                        uncheckedEnqueue(learnt_clause[0], cr);
                 }else{
 
                     assert(S);
@@ -2470,7 +2959,12 @@ lbool Solver::search(int nof_conflicts){
 
 
             // NO CONFLICT
-            if((opt_restarts && (nof_conflicts >= 0 && conflictC >= nof_conflicts)) || !withinBudget()){
+            //In focused mode, restart as soon as the recent learnt clauses are noticeably worse than average
+            bool focused_restart = opt_mode_switch && !stable_mode && conflictC >= 2 &&
+                                   lbd_ema_fast > opt_restart_margin * lbd_ema_slow;
+            bool mode_switch = opt_mode_switch && next_mode_switch > 0 && conflicts >= next_mode_switch;
+            if((opt_restarts && ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || focused_restart)) ||
+               mode_switch || !withinBudget()){
                 // Reached bound on number of conflicts:
                 progress_estimate = progressEstimate();
                 cancelUntil(initial_level);
@@ -2481,7 +2975,7 @@ lbool Solver::search(int nof_conflicts){
             if(decisionLevel() == 0 && !simplify())
                 return l_False;
 
-            if(learnts.size() - nAssigns() >= max_learnts)
+            if(learnts.size() - n_tiered_learnts - nAssigns() >= max_learnts)
                 // Reduce the set of learnt clauses:
                 reduceDB();
             Heuristic* next_decision_heuristic = nullptr;
@@ -2639,6 +3133,13 @@ lbool Solver::search(int nof_conflicts){
                     stats_theory_decisions++;
                     if(theoryDecision != lit_Undef && var(next) == var(theoryDecision)){
                         assigns[var(theoryDecision)] = l_Undef;
+                    }else if(stable_mode && opt_theory_target_phase && !opt_lazy_backtrack &&
+                             target_phase[var(next)] != l_Undef &&
+                             (target_phase[var(next)] == l_True) != sign(next)){
+                        //The theory picks which atom to decide next, but in stable mode its polarity follows the target
+                        //phase, so that theory decisions also steer back towards the longest conflict-free assignment.
+                        next = ~next;
+                        stats_theory_target_decisions++;
                     }
 
                     if(decision_reason != CRef_Undef){
@@ -2765,6 +3266,56 @@ lbool Solver::solveUntilRestart(const vec<Lit>& assumps){
     return val;
 }
 
+int Solver::lookahead(const vec<Lit>& path, Lit p){
+    if(!ok)
+        return -2;
+    bool path_assigned = decisionLevel() == path.size();
+    for(int i = 0; i < path.size() && path_assigned; i++){
+        path_assigned = value(path[i]) == l_True;
+    }
+    if(!path_assigned){
+        cancelUntil(0);
+        for(Lit l:path){
+            if(value(l) == l_False){
+                cancelUntil(0);
+                return -2;
+            }
+            newDecisionLevel();
+            if(value(l) == l_Undef)
+                uncheckedEnqueue(l);
+            if(propagate(true) != CRef_Undef || !ok){
+                cancelUntil(0);
+                return -2;
+            }
+        }
+        if(decisionLevel() != path.size()){
+            //a theory lemma caused a backjump while assigning the path; don't draw any conclusions from this call
+            cancelUntil(0);
+            return 0;
+        }
+    }
+    if(p == lit_Undef || value(p) == l_True)
+        return 0;
+    else if(value(p) == l_False)
+        return -1;
+    int lev = decisionLevel();
+    int start = trail.size();
+    newDecisionLevel();
+    uncheckedEnqueue(p);
+    CRef confl = propagate(true);
+    int n_implied = 0;
+    if(!ok){
+        n_implied = -2;
+    }else if(confl != CRef_Undef){
+        n_implied = decisionLevel() == lev + 1 ? -1 : 0;
+    }else if(decisionLevel() == lev + 1){
+        n_implied = trail.size() - start;
+    }
+    if(decisionLevel() > lev)
+        cancelUntil(lev);
+    return n_implied;
+}
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_(){
 #ifndef NDEBUG
@@ -2783,8 +3334,10 @@ lbool Solver::solve_(){
     cancelUntil(0);
     model.clear();
     conflict.clear();
-    if(!ok)
+    if(!ok){
+        logProof(ProofWriter::Step::Add, conflict);
         return l_False;
+    }
     if(pbsolver){
         pbsolver->convert();
     }
@@ -2858,8 +3411,37 @@ lbool Solver::solve_(){
             }
         }
 
+        if(clause_sharing && decisionLevel() == 0 && !importSharedClauses()){
+            status = l_False;
+            break;
+        }
+        if(opt_inprocess && decisionLevel() == 0){
+            if(next_inprocess == 0){
+                next_inprocess = conflicts + opt_inprocess_interval;
+            }else if(conflicts >= next_inprocess){
+                if(!inprocess()){
+                    status = l_False;
+                    break;
+                }
+                next_inprocess = conflicts + (uint64_t) opt_inprocess_interval * (inprocess_rounds + 1);
+            }
+        }
 
-        status = search(rest_base * restart_first);
+        int nof_conflicts = rest_base * restart_first;
+        if(opt_mode_switch){
+            if(next_mode_switch == 0){
+                next_mode_switch = conflicts + opt_mode_switch;
+            }else if(conflicts >= next_mode_switch){
+                switchMode();
+            }
+            if(stable_mode && opt_rephase_interval > 0 && conflicts >= next_rephase){
+                rephase();
+            }
+            //Focused mode restarts are triggered inside search() by the LBD averages
+            nof_conflicts = stable_mode ? luby(2, stable_restarts++) * opt_stable_restart_first : -1;
+        }
+
+        status = search(nof_conflicts);
         if(verbosity >= 1){
             printf("|r%9d | %7d %8d %8d | %8d %8d %6.0f | %" PRId64 " removed |\n", (int) conflicts,
                    (int) dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), nClauses(),
@@ -2994,6 +3576,11 @@ lbool Solver::solve_(){
     }else if(status == l_False){
         assert(ok);
     }
+    if(status == l_False && proof){
+        //the empty clause, or the clause over the failed assumptions
+        logLevelZeroTheoryReasons();
+        logProof(ProofWriter::Step::Add, conflict);
+    }
     quit_at_restart = false;
     only_propagate_assumptions = false;
     assumptions.clear();
@@ -3095,6 +3682,7 @@ void Solver::relocAll(ClauseAllocator& to){
     // All watchers:
     //
     watches.cleanAll();
+    watches_bin.cleanAll();
     for(int v = 0; v < nVars(); v++){
 
         for(int s = 0; s < 2; s++){
@@ -3102,6 +3690,9 @@ void Solver::relocAll(ClauseAllocator& to){
             vec<Watcher>& ws = watches[p];
             for(int j = 0; j < ws.size(); j++)
                 ca.reloc(ws[j].cref, to);
+            vec<Watcher>& wbin = watches_bin[p];
+            for(int j = 0; j < wbin.size(); j++)
+                ca.reloc(wbin[j].cref, to);
         }
     }
     // All reasons:
@@ -3130,8 +3721,8 @@ void Solver::garbageCollect(){
     ClauseAllocator to(ca.size() - ca.wasted());
     relocAll(to);
     if(verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n",
-               ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+               (uint64_t) ca.size() * ClauseAllocator::Unit_Size, (uint64_t) to.size() * ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
 
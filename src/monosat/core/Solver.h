@@ -33,6 +33,7 @@
 #include "monosat/core/Theory.h"
 #include "monosat/core/TheorySolver.h"
 #include "monosat/core/Config.h"
+#include "monosat/core/ProofWriter.h"
 #include <cinttypes>
 #include <map>
 #include <string>
@@ -48,12 +49,16 @@ class FSMTheorySolver;
 
 class DimacsMap;
 
+class ClauseSharing;
+
 //=================================================================================================
 // Solver -- the main class:
 // The MiniSAT Boolean SAT solver, extended to provided basic SMT support.
 class Solver : public Theory, public TheorySolver {
 public:
     void* _external_data = nullptr;//convenience pointer for external API.
+    ClauseSharing* clause_sharing = nullptr;//if set, short learnt clauses are exchanged with other solvers (see Portfolio.h)
+    ProofWriter* proof = nullptr;//if set, a DRAT proof is written as the solver runs (owned by the solver; see ProofWriter.h)
     static bool shown_warning;
 
     //fix this...
@@ -81,6 +86,9 @@ public:
 
     bool addClause(const vec<Lit>& ps) override;                     // Add a clause to the solver.
     virtual bool addEmptyClause();                             // Add the empty clause, making the solver contradictory.
+    virtual bool isEliminated(Var v) const{                    // True if v has been removed by preprocessing.
+        return false;
+    }
     bool addClause(Lit p) override;                                  // Add a unit clause to the solver.
     bool addClause(Lit p, Lit q) override;                           // Add a binary clause to the solver.
     bool addClause(Lit p, Lit q, Lit r) override;                    // Add a ternary clause to the solver.
@@ -297,11 +305,29 @@ public:
         printf("conflicts             : %-12" PRIu64 "   (%.0f /sec, %d learnts (%" PRId64 " theory learnts), %" PRId64 " removed)\n",
                conflicts,
                conflicts / cpu_time, learnts.size(), stats_theory_conflicts, stats_removed_clauses);
+        if(opt_lbd_tiers){
+            int n_core = 0, n_tier2 = 0, n_theory = 0;
+            for(CRef cr:learnts){
+                Clause& c = ca[cr];
+                if(c.derivedClause())
+                    n_theory++;
+                else if(c.lbd() <= (uint32_t) opt_lbd_core)
+                    n_core++;
+                else if(c.lbd() <= (uint32_t) opt_lbd_tier2)
+                    n_tier2++;
+            }
+            printf("learnt tiers          : %d core, %d tier2, %d local, %d theory lemmas (%" PRIu64
+                   " theory lemmas removed)\n", n_core, n_tier2, learnts.size() - n_core - n_tier2 - n_theory,
+                   n_theory, stats_removed_theory_lemmas);
+        }
         printf("decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", decisions,
                (float) rnd_decisions * 100 / (float) decisions, decisions / cpu_time);
         if(opt_decide_theories){
             printf("Theory decisions: %" PRId64 "\n", stats_theory_decisions);
             printf("Theory decision rounds: %" PRId64 "/%" PRId64 "\n", n_theory_decision_rounds, starts);
+            if(stats_theory_target_decisions > 0){
+                printf("Theory decisions following target phase: %" PRIu64 "\n", stats_theory_target_decisions);
+            }
         }
         if(opt_vsids_both){
             printf("Sovler pre-empted decisions: %" PRId64 "\n", stats_solver_preempted_decisions);
@@ -309,6 +335,22 @@ public:
         printf("propagations          : %-12" PRIu64 "   (%.0f /sec)\n", propagations, propagations / cpu_time);
         printf("conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", tot_literals,
                (max_literals - tot_literals) * 100 / (double) max_literals);
+        if(stats_chrono_backtracks > 0){
+            printf("chronological backtracks: %" PRIu64 "\n", stats_chrono_backtracks);
+        }
+        if(proof){
+            printf("proof                 : %" PRId64 " added, %" PRId64 " deleted, %" PRId64 " theory lemmas\n",
+                   proof->stats_added, proof->stats_deleted, proof->stats_theory_lemmas);
+        }
+        if(mode_switches > 0){
+            printf("mode switches         : %d (%d stable restarts, %d rephases, best trail %d)\n", mode_switches,
+                   stable_restarts, rephase_count, best_assigned);
+        }
+        if(inprocess_rounds > 0){
+            printf("inprocessing          : %d rounds (%" PRIu64 " learnts subsumed, %" PRIu64 " vivified, %" PRIu64
+                   " literals removed)\n", inprocess_rounds, stats_subsumed_learnts, stats_vivified_clauses,
+                   stats_vivified_lits);
+        }
         if(stats_skipped_theory_prop_rounds > 0){
             printf("theory propagations skipped: %" PRId64 "\n", stats_skipped_theory_prop_rounds);
         }
@@ -586,6 +628,11 @@ public:
             const vec<Lit>& assumps); //apply unit propagation to the supplied assumptions, and quit without solving
     virtual lbool
     solveUntilRestart(const vec<Lit>& assumps);//attempt to solve the instance, but quit as soon as the solver restarts
+    //Lookahead: assign each literal of 'path' at its own decision level, then assign p at a new level, and propagate
+    //(including theory propagation). Returns the number of literals assigned as a consequence of p, -1 if p is
+    //refuted under the path, or -2 if the path itself is refuted. If p is lit_Undef, only the path is assigned.
+    //The path is left assigned afterwards, so that repeated calls with the same path are cheap.
+    int lookahead(const vec<Lit>& path, Lit p);
     bool okay() const;                  // FALSE means solver is in a conflicting state
     void contradiction(){ //put the solver into a contradictory state
         ok = false;
@@ -725,6 +772,7 @@ public:
 
     void interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void clearInterrupt();     // Clear interrupt indicator flag.
+    bool isInterrupted() const;// True if an interrupt has been requested and not yet cleared.
 
     // Memory managment:
     //
@@ -807,6 +855,26 @@ public:
     CRef tmp_clause = CRef_Undef;
     vec<Lit> tmp_conflict;
     int tmp_clause_sz = 0;
+    vec<Lit> shared_clause;
+    uint64_t next_inprocess = 0;
+    vec<uint64_t> lbd_seen;
+    vec<CRef> reduce_local;
+    uint64_t lbd_stamp = 0;
+    int n_tiered_learnts = 0;    // Number of core and tier2 learnt clauses kept by the last call to reduceDB.
+    int inprocess_rounds = 0;
+    vec<Lit> proof_lits;
+    int proof_trail_head = 0;          // Level 0 trail position up to which theory reasons have been logged.
+    bool adding_derived_clauses = false; // Set while clauses derived by preprocessing are passed to addClause_.
+    bool stable_mode = false;    // True while in stable mode (rare restarts, decisions follow the target phase).
+    uint64_t next_mode_switch = 0;
+    int mode_switches = 0;
+    int stable_restarts = 0;
+    uint64_t next_rephase = 0;
+    int rephase_count = 0;
+    double lbd_ema_fast = 0;
+    double lbd_ema_slow = 0;
+    int target_assigned = 0;     // Length of the conflict-free trail prefix recorded in 'target_phase'.
+    int best_assigned = 0;       // Length of the conflict-free trail prefix recorded in 'best_phase'.
     Var max_super = var_Undef;
     Var min_super = var_Undef;
     Var min_local = var_Undef;
@@ -858,6 +926,11 @@ public:
     uint64_t stats_pure_theory_lits = 0;
     uint64_t pure_literal_detections = 0;
     uint64_t stats_removed_clauses = 0;
+    uint64_t stats_removed_theory_lemmas = 0;
+    uint64_t stats_chrono_backtracks = 0;
+    uint64_t stats_subsumed_learnts = 0;
+    uint64_t stats_vivified_clauses = 0;
+    uint64_t stats_vivified_lits = 0;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
     uint64_t stats_skipped_theory_prop_rounds = 0;
     uint64_t stats_theory_conflict_counter_restarts = 0;
@@ -870,6 +943,7 @@ public:
 
     uint64_t stats_solver_preempted_decisions = 0;
     uint64_t stats_theory_decisions = 0;
+    uint64_t stats_theory_target_decisions = 0;
     double stats_pure_lit_time = 0;
     uint64_t n_theory_conflicts = 0;
     int consecutive_theory_conflicts = 0;
@@ -907,6 +981,9 @@ protected:
             return cref != w.cref;
         }
     };
+#ifndef MONOSAT_LARGE_CLAUSE_ARENA
+    static_assert(sizeof(Watcher) == 8, "Watchers should be packed into 8 bytes");
+#endif
 
     struct WatcherDeleted {
         const ClauseAllocator& ca;
@@ -1024,10 +1101,13 @@ protected:
     vec<double> activity;         // A heuristic measurement of the activity of a variable.
     double var_inc;          // Amount to bump next variable with.
     OccLists<Lit, vec<Watcher>, WatcherDeleted> watches; // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<Watcher>, WatcherDeleted> watches_bin; // Binary clauses, kept apart from 'watches' (the blocker is the other literal).
     Heuristic* conflicting_heuristic = nullptr;
 
     vec<lbool> assigns;          // The current assignments.
     vec<char> polarity;         // The preferred polarity of each variable.
+    vec<lbool> target_phase;    // Polarity of each variable in the longest conflict-free trail since the last rephase (l_Undef if unset).
+    vec<lbool> best_phase;      // Polarity of each variable in the longest conflict-free trail seen so far (l_Undef if unset).
     vec<char> decision;         // Declares if a variable is eligible for selection in the decision heuristic.
     vec<int> priority;          // Static, lexicographic heuristic. Larger values are higher priority (decided first).
 
@@ -1088,6 +1168,14 @@ protected:
     //
     void insertVarOrder(Var x);                               // Insert a variable in the decision order priority queue.
     Lit pickBranchLit();                                                      // Return the next decision variable.
+    bool decisionPolarity(Var v) const{                       // The polarity to branch on for 'v' (target phase in stable mode).
+        if(stable_mode && target_phase[v] != l_Undef)
+            return target_phase[v] == l_True;
+        return polarity[v];
+    }
+    void updateTargetPhases();                                // Record the conflict-free trail prefix as the target (and best) phase.
+    void rephase();                                           // Reset the saved phases (best/inverted/random), and clear the target phase.
+    void switchMode();                                        // Switch between focused and stable mode.
 
 public:
     void instantiateLazyDecision(Lit l, int atLevel, CRef reason) override;
@@ -1131,6 +1219,12 @@ protected:
 
 
     CRef propagate(bool propagate_theories = true);    // Perform unit propagation. Returns possibly conflicting clause.
+    CRef propagateClauses(int& num_props);           // Unit propagation over the clauses only (no theories).
+    void prefetchClause(CRef cr) const{
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&ca[cr]);
+#endif
+    }
     void enqueueTheory(Lit l) override;
 
     void
@@ -1198,6 +1292,16 @@ protected:
     lbool search(int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool solve_();                                           // Main solve method (assumptions given in 'assumptions').
     void reduceDB();                                                      // Reduce the set of learnt clauses.
+    template<class C>
+    int computeLBD(const C& c);                  // Number of distinct decision levels in 'c' (unassigned literals count as the next level).
+    void exportLearntClause(const vec<Lit>& c, int lbd); // Offer a newly learnt clause to the clause_sharing buffer.
+    bool importSharedClauses();                     // Add clauses learnt by other solvers (at decision level 0).
+    template<class C>
+    void logProof(ProofWriter::Step step, const C& c); // Write 'c' to the proof, if proof logging is enabled.
+    void logLevelZeroTheoryReasons();               // Log the theory lemmas behind level 0 theory propagations.
+    virtual bool inprocess();                 // Simplify the clause database between restarts (at decision level 0).
+    void subsumeLearnts();                    // Remove learnt clauses that are subsumed by other clauses.
+    bool vivifyLearnts();                     // Shorten learnt clauses by propagating the negation of their literals.
     void removeSatisfied(vec<CRef>& cs);                           // Shrink 'cs' to contain only non-satisfied clauses.
     void rebuildOrderHeap();
 
@@ -1261,6 +1365,7 @@ protected:
     bool
     locked(const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
     bool satisfied(const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
+    void orderBinaryReason(Clause& c, Var x); // Move the literal of 'x' to the front of binary reason clause 'c'.
 
     void relocAll(ClauseAllocator& to);
 
@@ -1573,11 +1678,18 @@ inline bool Solver::addClause(Lit p, Lit q, Lit r){
 }
 
 inline bool Solver::locked(const Clause& c) const{
-    CRef r = reason(var(c[0]));
-    bool isClause = ca.isClause(r);
-    if(!isClause)
-        return false;
-    return value(c[0]) == l_True && ca.isClause(reason(var(c[0]))) && ca.lea(reason(var(c[0]))) == &c;
+    //binary clauses may be the reason for either of their literals (see propagate())
+    for(int i = 0; i < (c.size() == 2 ? 2 : 1); i++){
+        CRef r = reason(var(c[i]));
+        if(value(c[i]) == l_True && ca.isClause(r) && ca.lea(r) == &c)
+            return true;
+    }
+    return false;
+}
+
+inline void Solver::orderBinaryReason(Clause& c, Var x){
+    if(c.size() == 2 && var(c[0]) != x)
+        std::swap(c[0], c[1]);
 }
 
 inline void Solver::newDecisionLevel(){
@@ -1595,6 +1707,32 @@ inline int Solver::decisionLevel() const{
     return trail_lim.size();
 }
 
+template<class C>
+inline int Solver::computeLBD(const C& c){
+    if(lbd_seen.size() < decisionLevel() + 2)
+        lbd_seen.growTo(decisionLevel() + 2, 0);
+    lbd_stamp++;
+    int lbd = 0;
+    for(int i = 0; i < c.size(); i++){
+        int lev = value(c[i]) == l_Undef ? decisionLevel() + 1 : level(var(c[i]));
+        if(lbd_seen[lev] != lbd_stamp){
+            lbd_seen[lev] = lbd_stamp;
+            lbd++;
+        }
+    }
+    return lbd;
+}
+
+template<class C>
+inline void Solver::logProof(ProofWriter::Step step, const C& c){
+    if(proof){
+        proof_lits.clear();
+        for(int i = 0; i < c.size(); i++)
+            proof_lits.push(unmap(c[i]));
+        proof->write(step, proof_lits);
+    }
+}
+
 inline uint32_t Solver::abstractLevel(Var x) const{
     return 1 << (level(x) & 31);
 }
@@ -1649,6 +1787,8 @@ inline bool Solver::hasNextDecision() const{
 
 inline void Solver::setPolarity(Var v, bool b){
     polarity[v] = b;
+    target_phase[v] = l_Undef;
+    best_phase[v] = l_Undef;
 }
 
 inline void Solver::setDecisionVar(Var v, bool b){
@@ -1693,6 +1833,10 @@ inline void Solver::clearInterrupt(){
     asynch_interrupt = false;
 }
 
+inline bool Solver::isInterrupted() const{
+    return asynch_interrupt;
+}
+
 inline void Solver::budgetOff(){
     conflict_budget = propagation_budget = -1;
 }
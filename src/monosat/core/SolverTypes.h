@@ -25,6 +25,8 @@
 #define Monosat_SolverTypes_h
 
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 
 #include "monosat/mtl/IntTypes.h"
 #include "monosat/mtl/Alg.h"
@@ -216,7 +218,6 @@ class Clause {
         Lit lit;
         float act;
         uint32_t abs;
-        CRef rel;
     } data[0];
 
     friend class ClauseAllocator;
@@ -235,13 +236,21 @@ class Clause {
             data[i].lit = ps[i];
 
         if(header.has_extra){
-            if(header.learnt)
+            if(header.learnt){
                 data[header.size].act = 0;
-            else
+                data[header.size + 1].abs = 0;
+                data[header.size + 2].abs = 0;
+            }else
                 calcAbstraction();
         }
     }
 
+    //Learnt clauses store their activity, LBD, and the conflict at which they were last used after their literals;
+    //other clauses may store their abstraction.
+    static int extraWords(bool has_extra, bool learnt){
+        return has_extra ? (learnt ? 3 : 1) : 0;
+    }
+
 public:
     void calcAbstraction(){
         assert(header.has_extra);
@@ -258,15 +267,15 @@ public:
     //This is NOT safe. Only use this if it is guaranteed that the clause has enough extra allocated space
     void grow(int i){
         assert(i >= 0);
-        if(header.has_extra)
-            data[header.size + i] = data[header.size];
+        for(int k = extraWords(header.has_extra, header.learnt) - 1; k >= 0; k--)
+            data[header.size + i + k] = data[header.size + k];
         header.size += i;
     }
 
     void shrink(int i){
         assert(i <= size());
-        if(header.has_extra)
-            data[header.size - i] = data[header.size];
+        for(int k = 0; k < extraWords(header.has_extra, header.learnt); k++)
+            data[header.size - i + k] = data[header.size + k];
         header.size -= i;
     }
 
@@ -306,13 +315,16 @@ public:
         return header.reloced;
     }
 
+    //A CRef may be wider than one data word (see MONOSAT_LARGE_CLAUSE_ARENA, and ClauseAllocator::clauseWord32Size)
     CRef relocation() const{
-        return data[0].rel;
+        CRef c;
+        memcpy(&c, data, sizeof(CRef));
+        return c;
     }
 
     void relocate(CRef c){
         header.reloced = 1;
-        data[0].rel = c;
+        memcpy(data, &c, sizeof(CRef));
     }
 
     // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
@@ -334,6 +346,18 @@ public:
         return data[header.size].act;
     }
 
+    //literal block distance (number of distinct decision levels) of a learnt clause
+    uint32_t& lbd(){
+        assert(header.learnt);
+        return data[header.size + 1].abs;
+    }
+
+    //conflict count (truncated to 32 bits) at which this learnt clause was created or last took part in conflict analysis
+    uint32_t& lastUsed(){
+        assert(header.learnt);
+        return data[header.size + 2].abs;
+    }
+
     uint32_t abstraction() const{
         assert(header.has_extra);
         return data[header.size].abs;
@@ -359,8 +383,10 @@ public:
 const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
 
 class ClauseAllocator : public RegionAllocator<uint32_t> {
-    static int clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size + (int) has_extra))) / sizeof(uint32_t);
+    static int clauseWord32Size(int size, bool has_extra, bool learnt){
+        //leave room for a relocation reference, even in (degenerate) unit clauses
+        int data_words = std::max(size + Clause::extraWords(has_extra, learnt), (int) (sizeof(CRef) / sizeof(uint32_t)));
+        return (sizeof(Clause) + (sizeof(Lit) * data_words)) / sizeof(uint32_t);
     }
 
 public:
@@ -375,7 +401,7 @@ public:
         return cr < marker_refs;
     }
 
-    ClauseAllocator(uint32_t start_cap) :
+    ClauseAllocator(Ref start_cap) :
             RegionAllocator<uint32_t>(start_cap), extra_clause_field(false), marker_refs(CRef_Undef){
     }
 
@@ -394,7 +420,7 @@ public:
         static_assert(sizeof(float) == sizeof(uint32_t), "");
         bool use_extra = learnt | extra_clause_field;
 
-        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), use_extra));
+        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), use_extra, learnt));
         new(lea(cid)) Clause(ps, use_extra, learnt);
         return cid;
     }
@@ -426,7 +452,7 @@ public:
             return;
         }
         Clause& c = operator[](cid);
-        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
+        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra(), c.learnt()));
     }
 
     void reloc(CRef& cr, ClauseAllocator& to){
@@ -446,9 +472,11 @@ public:
         // Copy extra data-fields:
         // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
         to[cr].mark(c.mark());
-        if(to[cr].learnt())
+        if(to[cr].learnt()){
             to[cr].activity() = c.activity();
-        else if(to[cr].has_extra())
+            to[cr].lbd() = c.lbd();
+            to[cr].lastUsed() = c.lastUsed();
+        }else if(to[cr].has_extra())
             to[cr].calcAbstraction();
     }
 };
@@ -139,6 +139,11 @@ public:
         //do nothing
     }
 
+    //Append solver literals that are good candidates for splitting the search space on (e.g., for cube-and-conquer).
+    virtual void getSplittingLits(vec<Lit>& out){
+
+    }
+
     virtual void preprocess(){
 
     }
@@ -575,7 +575,8 @@ public:
 
     int maxDistance;
 
-    std::vector<int> q;
+    std::vector<int> q;//the nodes reached by the last search, in BFS order
+    std::vector<int> last_reached;
     std::vector<int> check;
     const int reportPolarity;
 
@@ -630,11 +631,14 @@ public:
         stats_fast_failed_updates = 0;
     }
 
+    //Nodes more than maxDistance steps from the source are reported as unreachable, and the search stops there.
+    //Changing the maximum distance forces the next update to search from scratch.
     void setMaxDistance(int& _maxDistance) override{
-        if(_maxDistance < 0){
-            maxDistance = inf();
-        }else
-            maxDistance = _maxDistance;
+        int d = _maxDistance < 0 ? inf() : _maxDistance;
+        if(d != maxDistance){
+            maxDistance = d;
+            last_modification = -1;
+        }
     }
 
     void setSource(int s) override{
@@ -673,6 +677,9 @@ public:
             stats_num_skipable_deletions++;
         }
 
+        //If the previous search is still valid for this graph, only the nodes it reached (the 'ball' within
+        //maxDistance of the source) need to be reset and re-reported, rather than every node in the graph.
+        bool full_reset = last_modification <= 0 || dist.size() != g.nodes();
         setNodes(g.nodes());
 
         if(g.nHistoryClears() != last_history_clear){
@@ -680,11 +687,19 @@ public:
             history_qhead = 0;
         }
 
-        q.clear();
-        for(int i = 0; i < g.nodes(); i++){
-            dist[i] = inf();
-            prev[i] = -1;
+        if(full_reset){
+            for(int i = 0; i < g.nodes(); i++){
+                dist[i] = inf();
+                prev[i] = -1;
+            }
+        }else{
+            for(int u:q){
+                dist[u] = inf();
+                prev[u] = -1;
+            }
         }
+        last_reached.swap(q);
+        q.clear();
 
         dist[source] = 0;
         q.push_back(source);
@@ -694,15 +709,14 @@ public:
             if(reportPolarity >= 0)
                 status.setMininumDistance(u, true, dist[u]);
             int d = dist[u];
+            if(d >= maxDistance)
+                continue;//Abort BFS early
             for(int i = 0; i < g.nIncident(u, undirected); i++){
                 if(!g.edgeEnabled(g.incident(u, i, undirected).id))
                     continue;
                 int edgeID = g.incident(u, i, undirected).id;
                 int v = g.incident(u, i, undirected).node;
-                int dv = dist[v];
                 int alt = d + 1;
-                if(alt > maxDistance)
-                    alt = inf();            //Abort BFS early
                 if(dist[v] > alt){
                     dist[v] = alt;
                     prev[v] = edgeID;
@@ -712,9 +726,18 @@ public:
         }
 
         if(reportPolarity <= 0){
-            for(int u = 0; u < g.nodes(); u++){
-                if(dist[u] >= inf()){
-                    status.setMininumDistance(u, dist[u] < inf(), dist[u]);
+            if(full_reset){
+                for(int u = 0; u < g.nodes(); u++){
+                    if(dist[u] >= inf()){
+                        status.setMininumDistance(u, dist[u] < inf(), dist[u]);
+                    }
+                }
+            }else{
+                //nodes outside of both the previous and the current ball were already reported as unreachable
+                for(int u:last_reached){
+                    if(dist[u] >= inf()){
+                        status.setMininumDistance(u, false, dist[u]);
+                    }
                 }
             }
         }
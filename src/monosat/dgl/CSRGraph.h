@@ -0,0 +1,313 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef CSR_GRAPH_H_
+#define CSR_GRAPH_H_
+
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include "Graph.h"
+#include "DynamicGraph.h"
+
+namespace dgl {
+
+
+/**
+ * A thin wrapper around a dynamic graph, which stores a frozen copy of the graph's adjacency lists in compressed sparse
+ * row (CSR) form: the incident edges of every node are stored contiguously in one array, rather than in a separate
+ * allocation per node, so traversals do not have to chase a pointer per node visited.
+ *
+ * Edges are never removed from a dynamic graph (only enabled and disabled), so the snapshot only has to be rebuilt
+ * when edges or nodes are added; it is rebuilt lazily, the next time the adjacency lists are read. The enabled/disabled
+ * state of each edge is not copied: it is read from the base graph's edge status bitset, indexed by edge ID.
+ * All other operations (including edge assignments and the history) are forwarded to the base graph.
+ */
+template<typename Weight, typename Base = DynamicGraph<Weight>>
+class CSRGraph final : public Graph<Weight> {
+public:
+    typedef typename Graph<Weight>::Edge Edge;
+    typedef typename Graph<Weight>::FullEdge FullEdge;
+    typedef typename Graph<Weight>::EdgeChange EdgeChange;
+private:
+    Base& base;
+
+    //A single CSR adjacency array: the edges of node n are edges[start[n]]..edges[start[n+1]-1]
+    struct Adjacency {
+        std::vector<int> start;
+        std::vector<Edge> edges;
+
+        inline int size(int node) const{
+            return start[node + 1] - start[node];
+        }
+
+        inline Edge& get(int node, int i){
+            assert(i >= 0 && i < size(node));
+            return edges[start[node] + i];
+        }
+    };
+
+    Adjacency out;
+    Adjacency in;
+    Adjacency undirected_adj;
+
+    int snapshot_nodes = -1;
+    int snapshot_edges = -1;
+
+public:
+    int64_t stats_rebuilds = 0;
+
+    CSRGraph(Base& base) : base(base){
+
+    }
+
+    ~CSRGraph(){
+
+    }
+
+    //Rebuild the snapshot now, if the base graph has had nodes or edges added since it was last built.
+    void freeze(){
+        sync();
+    }
+
+    bool isFrozen() const{
+        return snapshot_nodes == base.nodes() && snapshot_edges == base.nEdgeIDs();
+    }
+
+private:
+    inline void sync(){
+        if(snapshot_nodes != base.nodes() || snapshot_edges != base.nEdgeIDs()){
+            rebuild();
+        }
+    }
+
+    //Copies the base graph's adjacency lists, preserving their order (so that traversals visit edges in exactly the
+    //same order as they would on the base graph).
+    void rebuild(){
+        stats_rebuilds++;
+        snapshot_nodes = base.nodes();
+        snapshot_edges = base.nEdgeIDs();
+        build(out, false, false);
+        build(in, true, false);
+        build(undirected_adj, false, true);
+    }
+
+    void build(Adjacency& adj, bool incoming, bool undirected){
+        adj.start.clear();
+        adj.edges.clear();
+        adj.start.reserve(snapshot_nodes + 1);
+        int total = 0;
+        for(int n = 0; n < snapshot_nodes; n++){
+            adj.start.push_back(total);
+            total += incoming ? base.nIncoming(n, undirected) : base.nIncident(n, undirected);
+        }
+        adj.start.push_back(total);
+        adj.edges.reserve(total);
+        for(int n = 0; n < snapshot_nodes; n++){
+            int count = incoming ? base.nIncoming(n, undirected) : base.nIncident(n, undirected);
+            for(int i = 0; i < count; i++){
+                adj.edges.push_back(incoming ? base.incoming(n, i, undirected) : base.incident(n, i, undirected));
+            }
+        }
+    }
+
+public:
+
+    FILE* outfile() override{
+        return base.outfile();
+    };
+
+    void addNodes(int n) override{base.addNodes(n);};
+
+    //Returns true iff the edge exists and is a self loop
+    bool selfLoop(int edgeID) override{return base.selfLoop(edgeID);};
+
+    //SLOW!
+    bool hasEdge(int from, int to) const override{return base.hasEdge(from, to);};
+
+    //SLOW! Returns -1 if there is no edge
+    int getEdge(int from, int to) const override{return base.getEdge(from, to);};
+
+    bool hasEdgeUndirected(int from, int to) const override{return base.hasEdgeUndirected(from, to);};
+
+    int addNode() override{return base.addNode();};
+
+    //true iff the edge's current assignment will never be altered.
+    bool isConstant(int edgeID) const override{return base.isConstant(edgeID);};
+
+    void makeEdgeAssignmentConstant(int edgeID) override{base.makeEdgeAssignmentConstant(edgeID);};
+
+    inline bool edgeEnabled(int edgeID) const override{return base.edgeEnabled(edgeID);};
+
+    const alg::Bitset& getEdgeStatus() const override{return base.getEdgeStatus();};
+
+    int nEnabledEdges() const override{return base.nEnabledEdges();};
+
+    bool isEdge(int edgeID) const override{return base.isEdge(edgeID);};
+
+    bool hasEdge(int edgeID) const override{return base.hasEdge(edgeID);};
+
+    int addEdge(int from, int to, int id, Weight weight = 1) override{
+        return base.addEdge(from, to, id, weight);
+    };
+
+    int nEdgeIDs() override{return base.nEdgeIDs();};
+
+    int nodes() const override{return base.nodes();};
+
+    int edges() const override{return base.edges();};
+
+    inline int nIncident(int node, bool undirected = false) override{
+        sync();
+        return undirected ? undirected_adj.size(node) : out.size(node);
+    };
+
+    inline int nDirectedEdges(int node, bool incoming) override{
+        return incoming ? nIncoming(node, false) : nIncident(node, false);
+    };
+
+    inline Edge& directedEdges(int node, int i, bool is_incoming) override{
+        return is_incoming ? incoming(node, i, false) : incident(node, i, false);
+    };
+
+    inline int nIncoming(int node, bool undirected = false) override{
+        sync();
+        return undirected ? undirected_adj.size(node) : in.size(node);
+    };
+
+    //The snapshot must be up to date (as it is after any call to nIncident(), nIncoming() or freeze()).
+    inline Edge& incident(int node, int i, bool undirected = false) override{
+        assert(isFrozen());
+        return undirected ? undirected_adj.get(node, i) : out.get(node, i);
+    };
+
+    inline Edge& incoming(int node, int i, bool undirected = false) override{
+        assert(isFrozen());
+        return undirected ? undirected_adj.get(node, i) : in.get(node, i);
+    };
+
+    std::vector<FullEdge>& getEdges() override{return base.getEdges();};
+
+    std::vector<Weight>& getWeights() override{return base.getWeights();};
+
+    Weight getWeight(int edgeID) override{return base.getWeight(edgeID);};
+
+    FullEdge& getEdge(int id) override{return base.getEdge(id);};
+
+    void setEdgeEnabled(int id, bool enable) override{base.setEdgeEnabled(id, enable);};
+
+    void enableEdge(int id) override{base.enableEdge(id);};
+
+    void disableEdge(int id) override{base.disableEdge(id);};
+
+    void enableEdge(int from, int to, int id) override{base.enableEdge(from, to, id);};
+
+    bool undoEnableEdge(int id) override{return base.undoEnableEdge(id);};
+
+    void disableEdge(int from, int to, int id) override{return base.disableEdge(from, to, id);};
+
+    bool undoDisableEdge(int id) override{return base.undoDisableEdge(id);};
+
+    Weight getEdgeWeight(int edgeID) override{return base.getEdgeWeight(edgeID);};
+
+    void setEdgeWeight(int id, const Weight& w) override{base.setEdgeWeight(id, w);};
+
+    void drawFull(bool showWeights = false, bool force_draw = false) override{base.drawFull(showWeights, force_draw);};
+
+    bool rewindHistory(int steps) override{return base.rewindHistory(steps);};
+
+    /**
+     * Returns a unique identifier for this algorithm.
+     */
+    int addDynamicAlgorithm(DynamicGraphAlgorithm* alg) override{
+        if(alg == nullptr){
+            throw std::runtime_error("Internal error in CSRGraph (null dynamic graph algorithm)");
+        }
+        return base.addDynamicAlgorithm(alg);
+    };
+
+    void updateAlgorithmHistory(DynamicGraphAlgorithm* alg, int algorithmID, int historyPos) override{
+        if(algorithmID < 0 || alg == nullptr){
+            if(alg == nullptr){
+                throw std::runtime_error("Internal error in CSRGraph (invalid algorithm ID): algorithm " +
+                                         std::to_string(algorithmID) + ", null algorithm");
+            }else{
+                throw std::runtime_error("Internal error in CSRGraph (invalid algorithm ID): algorithm " +
+                                         std::to_string(algorithmID) + ", " + alg->getName());
+            }
+        }
+        base.updateAlgorithmHistory(alg, algorithmID, historyPos);
+    };
+
+    EdgeChange& getChange(int64_t historyPos) override{
+        return base.getChange(historyPos);
+    };
+
+    int historySize() override{return base.historySize();};
+
+    int nHistoryClears() const override{
+        return base.nHistoryClears();
+    }
+
+    int getCurrentHistory() const override{return base.getCurrentHistory();};
+
+    int nDeletions() const override{
+        return base.nDeletions();
+    };
+
+    int nAdditions() const override{
+        return base.nAdditions();
+    }
+
+    int lastEdgeIncrease() const override{
+        return base.lastEdgeIncrease();
+    }
+
+    int lastEdgeDecrease() const override{
+        return base.lastEdgeDecrease();
+    }
+
+    void clearHistory(bool forceClear = false) override{base.clearHistory(forceClear);};
+
+    void invalidate() override{base.invalidate();};
+
+    int64_t getPreviousHistorySize() const override{return base.getPreviousHistorySize();};
+
+    bool resumeHistory(int& historyPos) override{return base.resumeHistory(historyPos);};
+
+    void markChanged() override{base.markChanged();};
+
+    bool changed() override{return base.changed();};
+
+    void clearChanged() override{base.clearChanged();};
+
+    void clear() override{
+        base.clear();
+        snapshot_nodes = -1;
+        snapshot_edges = -1;
+    };
+};
+
+};
+#endif /* CSR_GRAPH_H_ */
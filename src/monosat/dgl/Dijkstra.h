@@ -385,6 +385,7 @@ public:
     int last_history_clear = 0;
 
     int source;
+    int maxDistance = -1;
 
     std::vector<int> dist;
     std::vector<int> prev;
@@ -441,6 +442,16 @@ public:
         return source;
     }
 
+    //Nodes more than maxDistance steps from the source are reported as unreachable (a negative maxDistance disables
+    //the limit). Changing the maximum distance forces the next update to recompute from scratch.
+    void setMaxDistance(int& _maxDistance) override{
+        int d = _maxDistance < 0 ? -1 : _maxDistance;
+        if(d != maxDistance){
+            maxDistance = d;
+            last_modification = -1;
+        }
+    }
+
     void drawFull(){
 
     }
@@ -509,6 +520,8 @@ public:
             if(dist[u] == inf())
                 break;
             q.removeMin();
+            if(maxDistance >= 0 && dist[u] >= maxDistance)
+                continue;//nodes past the maximum distance are left unreachable
             for(int i = 0; i < g.nIncident(u, undirected); i++){
                 if(!g.edgeEnabled(g.incident(u, i, undirected).id))
                     continue;
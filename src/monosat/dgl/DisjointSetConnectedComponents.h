@@ -111,13 +111,12 @@ public:
         sets.Reset();
         setNodes(g.nodes());
 
-        for(int i = 0; i < g.edges(); i++){
-            if(g.edgeEnabled(i)){
-                int u = g.getEdge(i).from;
-                int v = g.getEdge(i).to;
-                sets.UnionElements(u, v);
-            }
-        }
+        //only the words of the edge status bitset that have enabled edges are visited
+        g.getEdgeStatus().forEachSet([&](int i){
+            int u = g.getEdge(i).from;
+            int v = g.getEdge(i).to;
+            sets.UnionElements(u, v);
+        });
 
         status.setComponents(sets.NumSets());
 
@@ -94,6 +94,10 @@ public:
 
     bool edgeEnabled(int edgeID) const override{return base.edgeEnabled(edgeID);};
 
+    const alg::Bitset& getEdgeStatus() const override{return base.getEdgeStatus();};
+
+    int nEnabledEdges() const override{return base.nEnabledEdges();};
+
     bool isEdge(int edgeID) const override{return base.isEdge(edgeID);};
 
     bool hasEdge(int edgeID) const override{return base.hasEdge(edgeID);};
@@ -231,6 +235,8 @@ public:
 
     int64_t getPreviousHistorySize() const override{return base.getPreviousHistorySize();};
 
+    bool resumeHistory(int& historyPos) override{return base.resumeHistory(historyPos);};
+
     void markChanged() override{base.markChanged();};
 
     bool changed() override{return base.changed();};
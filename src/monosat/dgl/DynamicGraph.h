@@ -57,7 +57,7 @@ public:
     typedef typename Graph<Weight>::FullEdge FullEdge;
     typedef typename Graph<Weight>::EdgeChange EdgeChange;
 private:
-    std::vector<bool> edge_status;
+    alg::Bitset edge_status;//enabled state of each edge, by edge ID
     std::vector<bool> edge_status_const;
     std::vector<Weight> weights;
     int num_nodes = 0;
@@ -84,6 +84,7 @@ public:
     int64_t previous_history_size = 0;
     int64_t historyclears = 0;
     int64_t skipped_historyclears = 0;
+    int64_t carried_resumes = 0;//algorithms that resumed from changes carried over a history clear
 
     std::vector<std::vector<Edge>> adjacency_list;
     std::vector<std::vector<Edge>> inverted_adjacency_list;
@@ -100,6 +101,15 @@ public:
 
 private:
     std::vector<EdgeChange> history;
+
+    //A compacted checkpoint of the history as it was before the most recent history clear: the most recent enable or
+    //disable of each edge that changed, ordered by their positions in that history (see resumeHistory()).
+    std::vector<EdgeChange> carried_changes;
+    std::vector<int> carried_positions;
+    alg::Bitset carried_edges;
+    int64_t carried_start = 0;//the first position of the previous history that the checkpoint covers
+    int64_t carried_weight_change = -1;//the last position of a weight change in the previous history (or -1)
+    int64_t changed_position = -1;//the history position at which the graph was last marked changed
 public:
     //Logfile information if recording is enabled.
     FILE* _outfile = nullptr;
@@ -189,6 +199,14 @@ public:
         return edge_status[edgeID];
     }
 
+    const alg::Bitset& getEdgeStatus() const override{
+        return edge_status;
+    }
+
+    int nEnabledEdges() const override{
+        return edge_status.count();
+    }
+
     bool isEdge(int edgeID) const override{
         return edgeID < all_edges.size() && all_edges[edgeID].id == edgeID;
     }
@@ -361,7 +379,7 @@ public:
         assert(id < edge_status.size());
         assert(isEdge(id));
         if(!edge_status[id]){
-            edge_status[id] = true;
+            edge_status.set(id);
             modifications++;
             additions = modifications;
             history.push_back({true, false, false, false, id, modifications, additions});
@@ -384,7 +402,7 @@ public:
 
         if(history.back().addition && history.back().id == id && history.back().mod == modifications){
 
-            edge_status[id] = false;
+            edge_status.reset(id);
 
             if(_outfile){
                 fprintf(_outfile, "-%d\n", id + 1);
@@ -404,7 +422,7 @@ public:
         assert(id < edge_status.size());
         assert(isEdge(id));
         if(edge_status[id]){
-            edge_status[id] = false;
+            edge_status.reset(id);
 
             if(_outfile){
                 fprintf(_outfile, "-%d\n", id + 1);
@@ -426,7 +444,7 @@ public:
             return false;
 
         if(!history.back().addition && history.back().id == id && history.back().mod == modifications){
-            edge_status[id] = true;
+            edge_status.set(id);
 
             if(_outfile){
 
@@ -557,6 +575,11 @@ public:
     }
 
     EdgeChange& getChange(int64_t historyPos) override{
+        if(historyPos < 0){
+            //negative positions index the changes carried over from before the last history clear
+            assert(carried_changes.size() + historyPos >= 0);
+            return carried_changes[carried_changes.size() + historyPos];
+        }
         assert(historyPos - history_offset >= 0);
         assert(historyPos - history_offset < history.size());
         return history[historyPos - history_offset];
@@ -609,10 +632,12 @@ public:
                     return;
                 }
             }
-            previous_history_size = history.size();
+            checkpointHistory();
+            previous_history_size = historySize();
             history_offset = 0;
             history.clear();
             historyclears++;
+            changed_position = -1;
 
             if(_outfile){
                 fprintf(_outfile, "clearHistory\n");
@@ -622,6 +647,28 @@ public:
         }
     }
 
+    /**
+     * Maps a position in the history from before the most recent history clear onto the current history, so that an
+     * algorithm which had not processed all of the changes before that clear can still continue incrementally (rather
+     * than recomputing from scratch): replaying getChange() from the returned position visits each edge that was
+     * enabled or disabled at or after historyPos in the previous history (at most once, in order), followed by the
+     * current history. The caller must check that there has been exactly one history clear since it recorded
+     * historyPos. Returns false if those changes cannot be recovered (including if any edge weights changed).
+     */
+    bool resumeHistory(int& historyPos) override{
+        if(historyPos == previous_history_size){
+            historyPos = 0;
+            return true;
+        }
+        if(historyPos < carried_start || historyPos > previous_history_size || historyPos <= carried_weight_change)
+            return false;
+        int first = std::lower_bound(carried_positions.begin(), carried_positions.end(), historyPos)
+                    - carried_positions.begin();
+        historyPos = first - (int) carried_changes.size();
+        carried_resumes++;
+        return true;
+    }
+
     //force a new modification
     void invalidate() override{
         modifications++;
@@ -629,6 +676,7 @@ public:
         modifications++;
         deletions = modifications;
         is_changed = true;
+        changed_position = historySize();
 
         if(_outfile){
             fprintf(_outfile, "invalidate\n");
@@ -663,6 +711,7 @@ public:
 
     void markChanged() override{
         is_changed = true;
+        changed_position = historySize();
 
         if(_outfile){
             fprintf(_outfile, "markChanged\n");
@@ -675,6 +724,44 @@ public:
         return is_changed;
     }
 
+private:
+    //Records the most recent enable or disable of each edge in the current history, before it is cleared.
+    void checkpointHistory(){
+        carried_changes.clear();
+        carried_positions.clear();
+        carried_start = history_offset;
+        carried_weight_change = -1;
+        if(is_changed){
+            //algorithms recompute from scratch after the graph changes, so there is nothing to carry over
+            carried_start = historySize();
+            return;
+        }
+        if(changed_position >= carried_start){
+            //algorithms that had not caught up with the last change to the graph itself cannot resume
+            carried_start = changed_position + 1;
+        }
+        if(carried_edges.size() < next_id)
+            carried_edges.resize(next_id);
+        //walk backwards, so that the first change seen for each edge is its most recent one
+        for(int i = history.size() - 1; i >= 0; i--){
+            EdgeChange& change = history[i];
+            if(change.weight_increase || change.weight_decrease){
+                if(carried_weight_change < 0)
+                    carried_weight_change = i + history_offset;
+            }else if(!carried_edges[change.id]){
+                carried_edges.set(change.id);
+                carried_changes.push_back(change);
+                carried_positions.push_back(i + history_offset);
+            }
+        }
+        std::reverse(carried_changes.begin(), carried_changes.end());
+        std::reverse(carried_positions.begin(), carried_positions.end());
+        for(EdgeChange& change:carried_changes)
+            carried_edges.reset(change.id);
+    }
+
+public:
+
     void clearChanged() override{
         is_changed = false;
 
@@ -0,0 +1,134 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef EDGE_CHANGE_BATCH_H_
+#define EDGE_CHANGE_BATCH_H_
+
+#include <vector>
+#include <algorithm>
+#include "monosat/dgl/alg/Bitset.h"
+
+namespace dgl {
+
+/**
+ * The net effect of a range of a dynamic graph's history, for algorithms that are cheaper to update with all of the
+ * changes at once than by replaying the history one change at a time.
+ *
+ * Each edge appears at most once per list, and each list is sorted by edge ID. An edge that was enabled and then
+ * disabled again within the range (or vice versa) does not appear at all; only the final status of each edge matters.
+ */
+class EdgeChangeBatch {
+public:
+    std::vector<int> insertions;//edges that are now enabled, and were not at the start of the range
+    std::vector<int> deletions;//edges that are now disabled, and were not at the start of the range
+    std::vector<int> weight_changes;//edges whose weight was changed (these may also appear in the lists above)
+
+private:
+    alg::Bitset seen;
+    alg::Bitset seen_weight;
+    alg::Bitset start_enabled;//for each seen edge, whether it was enabled at the start of the range
+    alg::Bitset start_known;
+    std::vector<int> touched;
+
+    void growTo(int n){
+        if(seen.size() < n){
+            seen.resize(n);
+            seen_weight.resize(n);
+            start_enabled.resize(n);
+            start_known.resize(n);
+        }
+    }
+
+public:
+
+    void clear(){
+        insertions.clear();
+        deletions.clear();
+        weight_changes.clear();
+    }
+
+    int size() const{
+        return insertions.size() + deletions.size() + weight_changes.size();
+    }
+
+    bool empty() const{
+        return size() == 0;
+    }
+
+    /**
+     * Collects the changes from position 'historyPos' to the end of g's history.
+     * historyPos may be negative, if it was set by DynamicGraph::resumeHistory(); the status of an edge before a
+     * carried over change is unknown, so such edges are never treated as cancelled out.
+     */
+    template<class Graph>
+    void collect(Graph& g, int historyPos){
+        clear();
+        growTo(g.nEdgeIDs());
+        for(int i = historyPos; i < g.historySize(); i++){
+            auto& change = g.getChange(i);
+            int edgeID = change.id;
+            if(change.weight_increase || change.weight_decrease){
+                if(!seen_weight[edgeID]){
+                    seen_weight.set(edgeID);
+                    weight_changes.push_back(edgeID);
+                }
+            }else if(!seen[edgeID]){
+                seen.set(edgeID);
+                touched.push_back(edgeID);
+                //the first status change of an edge in the range tells us its status before the range
+                start_known.set(edgeID, i >= 0);
+                start_enabled.set(edgeID, !change.addition);
+            }
+        }
+        for(int edgeID:touched){
+            seen.reset(edgeID);
+            bool enabled = g.edgeEnabled(edgeID);
+            if(start_known[edgeID] && start_enabled[edgeID] == enabled)
+                continue;//this edge was enabled and then disabled again (or vice versa)
+            if(enabled)
+                insertions.push_back(edgeID);
+            else
+                deletions.push_back(edgeID);
+        }
+        touched.clear();
+        for(int edgeID:weight_changes)
+            seen_weight.reset(edgeID);
+        std::sort(insertions.begin(), insertions.end());
+        std::sort(deletions.begin(), deletions.end());
+        std::sort(weight_changes.begin(), weight_changes.end());
+    }
+
+    /**
+     * Collects the edges whose status differs between 'current' and 'previous' (for use when the history itself
+     * was lost). Weight changes cannot be recovered this way.
+     */
+    void collectDiff(const alg::Bitset& current, const alg::Bitset& previous){
+        clear();
+        current.forEachDiff(previous, [&](int edgeID, bool enabled){
+            if(enabled)
+                insertions.push_back(edgeID);
+            else
+                deletions.push_back(edgeID);
+        });
+    }
+};
+};
+#endif /* EDGE_CHANGE_BATCH_H_ */
@@ -73,19 +73,31 @@ class EdmondsKarpDynamic : public MaxFlow<Weight>, public DynamicGraphAlgorithm
 #endif
 
     std::vector<int> Q;
+    std::vector<int> searched;//the nodes whose prev[] entries were set by the last search
 
     std::vector<bool> edge_enabled;
 
-    Weight BreadthFirstSearch(int s, int t, Weight bound = -1){
-        for(int i = 0; i < g.nodes(); i++){ //this has to go...
-            prev[i].from = -1;
-        }
+    //Clears the prev[] entries set by the previous search (rather than clearing the entries of all nodes)
+    void resetSearch(int s){
+        for(int u:searched)
+            prev[u].from = -1;
+        searched.clear();
         prev[s].from = -2;
+        searched.push_back(s);
+    }
+
+    inline void visit(int v, const LocalEdge& e){
+        prev[v] = e;
+        searched.push_back(v);
+    }
+
+    Weight BreadthFirstSearch(int s, int t, Weight bound = -1){
+        resetSearch(s);
         Q.clear();
         Q.push_back(s);
         bool found = false;
         Weight& old_m = M[s];
-        for(int j = 0; j < Q.size(); j++){
+        for(int j = 0; j < Q.size() && !found; j++){
             int u = Q[j];
 
             for(int i = 0; i < g.nIncident(u); i++){
@@ -100,7 +112,7 @@ class EdmondsKarpDynamic : public MaxFlow<Weight>, public DynamicGraphAlgorithm
 
                 //  int fr = F[id];
                 if(((c - F[id]) > 0) && (prev[v].from == -1)){
-                    prev[v] = LocalEdge(u, id, false);
+                    visit(v, LocalEdge(u, id, false));
                     Weight b = c - F[id];
                     M[v] = std::min(M[u], b);
                     if(v != t)
@@ -124,7 +136,7 @@ class EdmondsKarpDynamic : public MaxFlow<Weight>, public DynamicGraphAlgorithm
                 Weight c = std::min(F[id], g.getWeight(id));
 
                 if(((c - f) > 0) && (prev[v].from == -1)){
-                    prev[v] = LocalEdge(u, id, true);
+                    visit(v, LocalEdge(u, id, true));
 
                     Weight b = c - f;
                     M[v] = std::min(M[u], b);
@@ -233,7 +245,11 @@ public:
             assert(curflow==expected_flow);
 #endif
             return curflow;
-        }else if(last_modification <= 0 || g.nHistoryClears() != last_history_clear || g.changed()){
+        }
+
+        bool added_Edges = false;
+        bool needsReflow = false;
+        if(last_modification <= 0 || g.changed() || edge_enabled.size() != g.edges()){
             F.clear();
             F.resize(g.edges());
             changed.resize(g.nEdgeIDs());
@@ -244,6 +260,7 @@ public:
                 prev[i].from = -1;
                 M[i] = 0;
             }
+            searched.clear();
             prev[s].from = -2;
             M[s] = INF;
             edge_enabled.resize(g.edges());
@@ -253,6 +270,27 @@ public:
             dbg_print_graph(s, t, -1, -1);
             f = maxFlow_p(s, t);
             dbg_print_graph(s, t, -1, -1);
+            //the flow was computed from the current graph, so there is no history left to replay
+            history_qhead = g.historySize();
+            last_history_clear = g.nHistoryClears();
+        }else if(last_history_clear != g.nHistoryClears()){
+            if(last_history_clear == g.nHistoryClears() - 1 && g.resumeHistory(history_qhead)){
+                //no information was lost in the history clear (or it was carried over)
+            }else{
+                //The history since the last update was lost. Instead of recomputing the flow from scratch, keep the
+                //existing flow, and repair only the edges whose flow is no longer feasible (because they were disabled,
+                //or their capacity decreased). Any other change can only increase the maximum flow, which the
+                //augmenting path search below will find, starting from the repaired flow.
+                for(int edgeid = 0; edgeid < g.edges(); edgeid++)
+                    edge_enabled[edgeid] = g.isEdge(edgeid) && g.edgeEnabled(edgeid);
+                for(int edgeid = 0; edgeid < g.edges(); edgeid++){
+                    if(reduceFlow(edgeid))
+                        needsReflow = true;
+                }
+                added_Edges = true;
+                history_qhead = g.historySize();
+            }
+            last_history_clear = g.nHistoryClears();
         }
 
 #ifdef DEBUG_MAXFLOW
@@ -265,8 +303,6 @@ public:
             }
         }
 #endif
-        bool added_Edges = false;
-        bool needsReflow = false;
 
         for(int i = history_qhead; i < g.historySize(); i++){
             int edgeid = g.getChange(i).id;
@@ -279,72 +315,14 @@ public:
                 added_Edges = true;
                 edge_enabled[edgeid] = true;
             }else if(g.getChange(i).weight_decrease && g.edgeEnabled(edgeid)){
-                Weight fv = F[edgeid];
                 edge_enabled[edgeid] = true;
-                //check if the maxflow from u to v has not lowered now that we've decreased this edge.
-                //if it hasn't, then we are still safe
-                int u = g.getEdge(edgeid).from;
-                int v = g.getEdge(edgeid).to;
-
-                if(fv < 0){
-                    std::swap(u, v);
-                    fv = -fv;
-                }
-                assert(fv >= 0);
-                if(fv > g.getWeight(edgeid)){
-
-                    Weight diff = fv - g.getWeight(edgeid);
-                    F[edgeid] = g.getWeight(edgeid);
-                    //F[edgeid] = std::min(F[edgeid],g.getWeight(edgeid));
-                    Weight flow = maxFlow_residual(u, v, diff);                        //fix this!
-                    assert(flow <= diff);
-                    assert(diff >= 0);
-                    if(flow == diff){
-                        //then we are ok.
-                    }else{
-
-                        //the total flow in the network has to be decreased by delta.
-                        Weight delta = diff - flow;
-                        assert(delta > 0);
-                        needsReflow = true;
-                        //temporarily connect s and t by an arc of infinite capacity and run maxflow algorithm again from vin to vout
-                        flow = maxFlow_p(u, v, s, t, delta);
-
-                    }
-
-                    markChanged(edgeid);
-                }
+                if(reduceFlow(edgeid))
+                    needsReflow = true;
             }else if(!g.getChange(i).addition && !g.edgeEnabled(edgeid)){
                 //assert(edge_enabled[edgeid]);
                 edge_enabled[edgeid] = false;
-                Weight fv = F[edgeid]; //g.all_edges[edgeid].from;
-                if(fv > 0){
-                    //ok, check if the maxflow from u to v has not lowered now that we've removed this edge.
-                    //if it hasn't, then we are still safe
-                    int u = g.getEdge(edgeid).from;
-                    int v = g.getEdge(edgeid).to;
-
-                    if(fv < 0){
-                        std::swap(u, v);
-                        fv = -fv;
-                    }
-                    assert(fv >= 0);
-                    Weight flow = maxFlow_residual(u, v, fv);                        //fix this!
-                    assert(flow <= fv);
-                    if(flow == fv){
-                        //then we are ok.
-                    }else{
-                        //the total flow in the network has to be decreased by delta.
-                        Weight delta = fv - flow;
-                        assert(delta > 0);
-                        needsReflow = true;
-                        //temporarily connect s and t by an arc of infinite capacity and run maxflow algorithm again from vin to vout
-                        flow = maxFlow_p(u, v, s, t, delta);
-                        //f-=flow;//this doesn't work
-                    }
-                    F[edgeid] = 0;
-                    markChanged(edgeid);
-                }
+                if(reduceFlow(edgeid))
+                    needsReflow = true;
             }
         }
 
@@ -468,6 +446,35 @@ private:
         }
     }
 
+    //If the flow through edgeID exceeds its capacity (which is 0 if the edge is disabled), reroute the excess
+    //flow around the edge if possible; any flow that can't be rerouted is removed from the s-t flow.
+    //Returns true if the s-t flow was reduced (in which case it must be recounted).
+    bool reduceFlow(int edgeid){
+        Weight capacity = edge_enabled[edgeid] ? g.getWeight(edgeid) : 0;
+        Weight fv = F[edgeid];
+        if(fv <= capacity)
+            return false;
+        //check if the maxflow from u to v has not lowered now that we've decreased this edge.
+        //if it hasn't, then we are still safe
+        int u = g.getEdge(edgeid).from;
+        int v = g.getEdge(edgeid).to;
+        Weight diff = fv - capacity;
+        F[edgeid] = capacity;
+        markChanged(edgeid);
+        Weight flow = maxFlow_residual(u, v, diff);
+        assert(flow <= diff);
+        if(flow == diff){
+            //then we are ok.
+            return false;
+        }
+        //the total flow in the network has to be decreased by delta.
+        Weight delta = diff - flow;
+        assert(delta > 0);
+        //temporarily connect s and t by an arc of infinite capacity and run maxflow algorithm again from vin to vout
+        maxFlow_p(u, v, source, sink, delta);
+        return true;
+    }
+
     Weight maxFlow_residual(int s, int t, Weight bound){
         Weight new_flow = 0;
         while(true){
@@ -541,9 +548,7 @@ private:
      */
     Weight BreadthFirstSearch(int s, int t, int shortCircuitFrom, int shortCircuitTo, Weight& shortCircuitCapacity,
                               Weight& shortCircuitFlow, bool allow_flow_cycles = true){
-        for(int i = 0; i < g.nodes(); i++)                        //this has to go...
-            prev[i].from = -1;
-        prev[s].from = -2;
+        resetSearch(s);
         Q.clear();
         Q.push_back(s);
 
@@ -555,7 +560,7 @@ private:
                 Weight f = shortCircuitFlow;
                 Weight c = shortCircuitCapacity;
                 if(((c - f) > 0)){
-                    prev[v] = {u, -1};
+                    visit(v, LocalEdge(u, -1));
                     Weight b = c - f;
                     M[v] = std::min(M[u], b);
                     if(v != t)
@@ -578,7 +583,7 @@ private:
 
                 //  int fr = F[id];
                 if(((c - f) > 0) && (prev[v].from == -1)){
-                    prev[v] = LocalEdge(u, id, true);
+                    visit(v, LocalEdge(u, id, true));
                     Weight b = c - f;
                     M[v] = std::min(M[u], b);
                     if(v != t)
@@ -599,7 +604,7 @@ private:
                     const Weight& c = g.getWeight(id);
 
                     if(((c - f) > 0) && (prev[v].from == -1)){
-                        prev[v] = LocalEdge(u, id, false);
+                        visit(v, LocalEdge(u, id, false));
                         Weight b = c - f;
 
                         M[v] = std::min(M[u], b);
@@ -0,0 +1,384 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef EVEN_SHILOACH_H_
+#define EVEN_SHILOACH_H_
+
+#include <vector>
+#include <string>
+#include <cinttypes>
+#include <cstdio>
+#include "monosat/dgl/alg/Heap.h"
+#include "monosat/dgl/alg/Bitset.h"
+#include "Graph.h"
+#include "DynamicGraph.h"
+#include "Distance.h"
+
+namespace dgl {
+
+/**
+ * Weighted single source shortest paths, maintained incrementally in the style of an Even-Shiloach tree, and truncated
+ * at a maximum distance (see setMaxDistance()): nodes further than that from the source are reported as unreachable.
+ *
+ * Each node within the horizon keeps the tree edge of one of its shortest paths. Disabling an edge that is not a tree
+ * edge costs nothing; disabling a tree edge detaches the subtree below it, and only the detached nodes are re-settled
+ * (by Dijkstra's algorithm, seeded from their surviving in-neighbours). Enabling an edge relaxes forward from its
+ * head. Nodes beyond the horizon are never settled, so when the thresholds are small only a ball around the source
+ * is ever touched.
+ *
+ * Edge weights must be non-negative, and must not change (any weight change triggers a full recomputation).
+ */
+template<typename Weight = int64_t, typename Graph = DynamicGraph<Weight>, class Status = typename Distance<Weight>::NullStatus>
+class EvenShiloach : public Distance<Weight>, public DynamicGraphAlgorithm {
+    using Distance<Weight>::inf;
+    using Distance<Weight>::unreachable;
+public:
+    Graph& g;
+    Status& status;
+    int reportPolarity;
+
+    int last_modification = -1;
+    int history_qhead = 0;
+    int last_history_clear = 0;
+    int alg_id = -1;
+
+    int source;
+    //Distances greater than this are not computed (or -1, to compute all distances)
+    Weight maxDistance = -1;
+
+    std::vector<Weight> dist;
+    std::vector<int> prev;//the tree edge into each node, or -1
+    alg::Bitset edge_enabled;//the enabled edges, as of the last update
+
+    struct DistCmp {
+        std::vector<Weight>& _dist;
+
+        bool operator()(int a, int b) const{
+            return _dist[a] < _dist[b];
+        }
+
+        DistCmp(std::vector<Weight>& d) :
+                _dist(d){
+        };
+    };
+
+    alg::Heap<DistCmp> q;
+
+    std::vector<int> added_edges;
+    std::vector<int> removed_edges;
+    std::vector<int> detached;
+    std::vector<char> is_detached;
+    std::vector<int> changed;
+    std::vector<char> node_changed;
+
+public:
+    int64_t num_updates = 0;
+    int64_t stats_full_updates = 0;
+    int64_t stats_fast_updates = 0;
+    int64_t stats_skipped_deletions = 0;
+    int64_t stats_detached_nodes = 0;
+    int64_t stats_settled_nodes = 0;
+
+    EvenShiloach(int s, Graph& graph, Status& status, int reportPolarity = 0) :
+            g(graph), status(status), reportPolarity(reportPolarity), source(s), q(DistCmp(dist)){
+        alg_id = g.addDynamicAlgorithm(this);
+    }
+
+    EvenShiloach(int s, Graph& graph, int reportPolarity = 0) :
+            g(graph), status(Distance<Weight>::nullStatus), reportPolarity(reportPolarity), source(s),
+            q(DistCmp(dist)){
+        alg_id = g.addDynamicAlgorithm(this);
+    }
+
+    std::string getName() override{
+        return "EvenShiloach(" + std::to_string(getSource()) + ")";
+    }
+
+    void printStats() override{
+        printf("Updates: %" PRId64 " (%" PRId64 " full, %" PRId64 " incremental), %" PRId64
+               " deletions skipped, %" PRId64 " nodes detached, %" PRId64 " nodes settled\n", num_updates,
+               stats_full_updates, stats_fast_updates, stats_skipped_deletions, stats_detached_nodes,
+               stats_settled_nodes);
+    }
+
+    void setSource(int s) override{
+        source = s;
+        last_modification = -1;
+    }
+
+    int getSource() override{
+        return source;
+    }
+
+    int numUpdates() const override{
+        return num_updates;
+    }
+
+    //Nodes further than maxDistance from the source will be reported as unreachable (or pass a negative distance to
+    //compute all distances). Changing the maximum distance forces the next update to recompute from scratch.
+    void setMaxDistance(Weight& _maxDistance) override{
+        Weight d = _maxDistance;
+        if(d < 0)
+            d = -1;
+        if(d != maxDistance){
+            maxDistance = d;
+            last_modification = -1;
+        }
+    }
+
+    void updateHistory() override{
+        update();
+    }
+
+    void update() override{
+        if(last_modification > 0 && g.getCurrentHistory() == last_modification)
+            return;
+
+        if(last_modification <= 0 || g.changed() || dist.size() != g.nodes()){
+            recompute();
+        }else if(!collectChanges()){
+            recompute();
+        }else{
+            stats_fast_updates++;
+            for(int edgeID:removed_edges){
+                int v = g.getEdge(edgeID).to;
+                if(prev[v] == edgeID){
+                    detach(v);
+                }else{
+                    stats_skipped_deletions++;
+                }
+            }
+            reattach();
+            for(int edgeID:added_edges){
+                int u = g.getEdge(edgeID).from;
+                if(dist[u] < inf()){
+                    relax(u, edgeID);
+                }
+            }
+            settle();
+        }
+        report();
+
+        num_updates++;
+        last_modification = g.getCurrentHistory();
+        history_qhead = g.historySize();
+        last_history_clear = g.nHistoryClears();
+        g.updateAlgorithmHistory(this, alg_id, history_qhead);
+    }
+
+private:
+
+    inline bool withinHorizon(const Weight& d) const{
+        return maxDistance < 0 || d <= maxDistance;
+    }
+
+    inline void setDistance(int v, const Weight& d, int edgeID){
+        if(!node_changed[v]){
+            node_changed[v] = true;
+            changed.push_back(v);
+        }
+        dist[v] = d;
+        prev[v] = edgeID;
+    }
+
+    inline void relax(int u, int edgeID){
+        int v = g.getEdge(edgeID).to;
+        Weight alt = dist[u] + g.getWeight(edgeID);
+        if(alt < dist[v] && withinHorizon(alt)){
+            setDistance(v, alt, edgeID);
+            q.update(v);
+        }
+    }
+
+    //Dijkstra's algorithm from the nodes in the queue, stopping at the horizon
+    void settle(){
+        while(q.size()){
+            int u = q.removeMin();
+            stats_settled_nodes++;
+            for(int i = 0; i < g.nIncident(u); i++){
+                int edgeID = g.incident(u, i).id;
+                if(g.edgeEnabled(edgeID))
+                    relax(u, edgeID);
+            }
+        }
+    }
+
+    void recompute(){
+        stats_full_updates++;
+        int n = g.nodes();
+        dist.resize(n);
+        prev.resize(n);
+        node_changed.resize(n, false);
+        is_detached.resize(n, false);
+        changed.clear();
+        q.clear();
+        for(int i = 0; i < n; i++){
+            dist[i] = inf();
+            prev[i] = -1;
+            //On a full recomputation, report the status of all nodes.
+            node_changed[i] = true;
+            changed.push_back(i);
+        }
+        if(source < n){
+            dist[source] = 0;
+            q.insert(source);
+        }
+        settle();
+        g.getEdgeStatus().copyTo(edge_enabled);
+    }
+
+    //Collects the edges enabled and disabled since the last update. Returns false if that information was lost
+    //(in which case the distances must be recomputed).
+    bool collectChanges(){
+        added_edges.clear();
+        removed_edges.clear();
+        if(last_history_clear != g.nHistoryClears()){
+            if(last_history_clear == g.nHistoryClears() - 1 && g.resumeHistory(history_qhead)){
+                //no information was lost in the history clear (or it was carried over)
+            }else{
+                //recover the changes from the edge status instead
+                bool weights_unchanged = g.lastEdgeIncrease() <= last_modification
+                                         && g.lastEdgeDecrease() <= last_modification;
+                if(!weights_unchanged)
+                    return false;
+                g.getEdgeStatus().forEachDiff(edge_enabled, [&](int edgeID, bool enabled){
+                    if(enabled)
+                        added_edges.push_back(edgeID);
+                    else
+                        removed_edges.push_back(edgeID);
+                });
+                g.getEdgeStatus().copyTo(edge_enabled);
+                return true;
+            }
+        }
+        edge_enabled.resize(g.nEdgeIDs());
+        for(int i = history_qhead; i < g.historySize(); i++){
+            auto& change = g.getChange(i);
+            if(change.weight_increase || change.weight_decrease)
+                return false;
+            int edgeID = change.id;
+            bool enabled = g.edgeEnabled(edgeID);
+            if(enabled == edge_enabled[edgeID])
+                continue;//this edge was enabled and then disabled again (or vice versa)
+            edge_enabled.set(edgeID, enabled);
+            if(enabled)
+                added_edges.push_back(edgeID);
+            else
+                removed_edges.push_back(edgeID);
+        }
+        return true;
+    }
+
+    //Disconnects the subtree rooted at 'root' from the shortest path tree
+    void detach(int root){
+        if(is_detached[root] || dist[root] >= inf())
+            return;
+        int start = detached.size();
+        is_detached[root] = true;
+        detached.push_back(root);
+        for(int j = start; j < detached.size(); j++){
+            int u = detached[j];
+            setDistance(u, inf(), -1);
+            for(int i = 0; i < g.nIncident(u); i++){
+                int edgeID = g.incident(u, i).id;
+                int v = g.incident(u, i).node;
+                if(prev[v] == edgeID && !is_detached[v]){
+                    is_detached[v] = true;
+                    detached.push_back(v);
+                }
+            }
+        }
+    }
+
+    //Seeds each detached node with its best surviving in-neighbour (if any is within the horizon)
+    void reattach(){
+        stats_detached_nodes += detached.size();
+        for(int v:detached){
+            for(int i = 0; i < g.nIncoming(v); i++){
+                int edgeID = g.incoming(v, i).id;
+                int u = g.incoming(v, i).node;
+                if(!is_detached[u] && dist[u] < inf() && g.edgeEnabled(edgeID)){
+                    relax(u, edgeID);
+                }
+            }
+        }
+        for(int v:detached)
+            is_detached[v] = false;
+        detached.clear();
+    }
+
+    void report(){
+        for(int u:changed){
+            node_changed[u] = false;
+            if(reportPolarity <= 0 && dist[u] >= inf()){
+                status.setReachable(u, false);
+                status.setMininumDistance(u, false, dist[u]);
+            }else if(reportPolarity >= 0 && dist[u] < inf()){
+                status.setReachable(u, true);
+                status.setMininumDistance(u, true, dist[u]);
+            }
+        }
+        changed.clear();
+    }
+
+public:
+
+    bool connected_unsafe(int t) override{
+        return t < dist.size() && dist[t] < inf();
+    }
+
+    bool connected_unchecked(int t) override{
+        assert(last_modification == g.getCurrentHistory());
+        return connected_unsafe(t);
+    }
+
+    bool connected(int t) override{
+        update();
+        return connected_unsafe(t);
+    }
+
+    Weight& distance(int t) override{
+        update();
+        if(connected_unsafe(t))
+            return dist[t];
+        return this->unreachable();
+    }
+
+    Weight& distance_unsafe(int t) override{
+        if(connected_unsafe(t))
+            return dist[t];
+        return this->unreachable();
+    }
+
+    int incomingEdge(int t) override{
+        assert(t >= 0 && t < prev.size());
+        return prev[t];
+    }
+
+    int previous(int t) override{
+        if(prev[t] < 0)
+            return -1;
+        assert(g.getEdge(prev[t]).to == t);
+        return g.getEdge(prev[t]).from;
+    }
+};
+};
+#endif /* EVEN_SHILOACH_H_ */
@@ -30,6 +30,7 @@
 #include <cstdint>
 #include <sstream>
 #include <cstdio>
+#include "monosat/dgl/alg/Bitset.h"
 
 namespace dgl {
 /**
@@ -112,6 +113,14 @@ public:
 
     virtual bool edgeEnabled(int edgeID) const = 0;
 
+    //The enabled state of every edge, by edge ID, packed 64 edges to a word. Algorithms that keep their own snapshot
+    //of this bitset can find the edges that changed since the snapshot with Bitset::forEachDiff(), instead of
+    //replaying the history.
+    virtual const alg::Bitset& getEdgeStatus() const = 0;
+
+    //Number of currently enabled edges
+    virtual int nEnabledEdges() const = 0;
+
     virtual bool isEdge(int edgeID) const = 0;
 
     virtual bool hasEdge(int edgeID) const = 0;
@@ -197,6 +206,10 @@ public:
 
     virtual int64_t getPreviousHistorySize() const = 0;
 
+    //Maps a history position recorded before the last history clear onto the current history; returns false if the
+    //changes since that position were lost.
+    virtual bool resumeHistory(int& historyPos) = 0;
+
     virtual void markChanged() = 0;
 
     virtual bool changed() = 0;
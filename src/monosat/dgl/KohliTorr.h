@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "EdmondsKarpDynamic.h"
+#include "EdgeChangeBatch.h"
 #include <algorithm>
 #include <limits>
 
@@ -105,6 +106,7 @@ class KohliTorr : public MaxFlow<Weight>, public DynamicGraphAlgorithm {
     Weight sum_of_edge_capacities = 0;
     std::vector<Weight> local_weights;
     std::vector<bool> edge_enabled;
+    EdgeChangeBatch batch;
     std::vector<int> changed_edges;
     std::vector<int> changed_partition;
     bool flow_needs_recalc = true;
@@ -639,9 +641,8 @@ public:
                  || edge_enabled.size() != g.edges()){
             initKT();
         }else if(!g.changed() && last_history_clear >= 0 && last_history_clear == g.nHistoryClears() - 1 &&
-                 history_qhead == g.getPreviousHistorySize()){
-            //no information was lost in the history clear
-            history_qhead = 0;
+                 g.resumeHistory(history_qhead)){
+            //no information was lost in the history clear (or it was carried over)
             last_history_clear = g.nHistoryClears();
         }else if(g.nHistoryClears() != last_history_clear || g.changed()){
             stats_reinits++;
@@ -699,50 +700,51 @@ public:
 
         assert(kt);
 
-        for(int i = history_qhead; i < g.historySize(); i++){
-            int edgeid = g.getChange(i).id;
-            int from = g.getEdge(edgeid).from;
-            int to = g.getEdge(edgeid).to;
-            if(g.selfLoop(edgeid))
-                continue; //skip self loops
-            if(g.getChange(i).addition && g.edgeEnabled(edgeid) && !edge_enabled[edgeid]){
-
-
-                assert(local_weight(edgeid) == 0);
-                edge_enabled[edgeid] = true;
-                set_local_weight(edgeid, g.getWeight(edgeid));
+        //Apply the net changes since the last update all at once: each edge is edited at most once, no matter how
+        //many times it was toggled, and all the deletions are applied before any of the insertions.
+        batch.collect(g, history_qhead);
+        for(int edgeid:batch.deletions){
+            if(g.selfLoop(edgeid) || !edge_enabled[edgeid])
+                continue; //skip self loops (and edges that were never added to the flow graph)
+            typename kohli_torr::Graph<Weight, Weight, Weight>::arc_id arcID = getArc(edgeid);
+            edge_enabled[edgeid] = false;
 
-                kt->edit_edge_inc(g.getEdge(edgeid).from, g.getEdge(edgeid).to, g.getWeight(edgeid), 0, getArc(edgeid));
-                if(curflow < static_maxflow){
+            if(kt->get_flow(arcID) > 0){
 
-                    needs_recompute = true;
-                }
-            }else if((g.getChange(i).weight_increase || g.getChange(i).weight_decrease) && g.edgeEnabled(edgeid) &&
-                     edge_enabled[edgeid] && g.getWeight(edgeid) != local_weight(edgeid)){
-                typename kohli_torr::Graph<Weight, Weight, Weight>::arc_id arcID = getArc(edgeid);
-                Weight dif = g.getWeight(edgeid) - local_weight(edgeid);
+                needs_recompute = true;
+            }
+            kt->edit_edge_inc(g.getEdge(edgeid).from, g.getEdge(edgeid).to, -local_weight(edgeid), 0, arcID);
+            set_local_weight(edgeid, 0);
+        }
+        for(int edgeid:batch.insertions){
+            if(g.selfLoop(edgeid) || edge_enabled[edgeid])
+                continue; //skip self loops (and edges that are already in the flow graph)
+            assert(local_weight(edgeid) == 0);
+            edge_enabled[edgeid] = true;
+            set_local_weight(edgeid, g.getWeight(edgeid));
 
-                if(dif < 0 && kt->get_flow(arcID) > 0){
+            kt->edit_edge_inc(g.getEdge(edgeid).from, g.getEdge(edgeid).to, g.getWeight(edgeid), 0, getArc(edgeid));
+            if(curflow < static_maxflow){
 
-                    needs_recompute = true;
-                }
-                kt->edit_edge_inc(g.getEdge(edgeid).from, g.getEdge(edgeid).to, dif, 0, getArc(edgeid));
-                set_local_weight(edgeid, g.getWeight(edgeid));
-                if(dif > 0 && curflow < static_maxflow){
+                needs_recompute = true;
+            }
+        }
+        for(int edgeid:batch.weight_changes){
+            if(g.selfLoop(edgeid) || !g.edgeEnabled(edgeid) || !edge_enabled[edgeid] ||
+               g.getWeight(edgeid) == local_weight(edgeid))
+                continue;
+            typename kohli_torr::Graph<Weight, Weight, Weight>::arc_id arcID = getArc(edgeid);
+            Weight dif = g.getWeight(edgeid) - local_weight(edgeid);
 
-                    needs_recompute = true;
-                }
-            }else if(g.getChange(i).deletion && !g.edgeEnabled(edgeid) && edge_enabled[edgeid]){
-                typename kohli_torr::Graph<Weight, Weight, Weight>::arc_id arcID = getArc(edgeid);
-                assert(edge_enabled[edgeid]);
-                edge_enabled[edgeid] = false;
+            if(dif < 0 && kt->get_flow(arcID) > 0){
 
-                if(kt->get_flow(arcID) > 0){
+                needs_recompute = true;
+            }
+            kt->edit_edge_inc(g.getEdge(edgeid).from, g.getEdge(edgeid).to, dif, 0, getArc(edgeid));
+            set_local_weight(edgeid, g.getWeight(edgeid));
+            if(dif > 0 && curflow < static_maxflow){
 
-                    needs_recompute = true;
-                }
-                kt->edit_edge_inc(g.getEdge(edgeid).from, g.getEdge(edgeid).to, -local_weight(edgeid), 0, arcID);
-                set_local_weight(edgeid, 0);
+                needs_recompute = true;
             }
         }
         if(sum_of_edge_capacities > max_capacity || max_capacity_increased){
@@ -0,0 +1,502 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef LINK_CUT_MST_H_
+#define LINK_CUT_MST_H_
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cinttypes>
+#include "monosat/dgl/alg/LinkCutMax.h"
+#include "monosat/dgl/alg/DisjointSets.h"
+#include "monosat/dgl/alg/Bitset.h"
+#include "Graph.h"
+#include "MinimumSpanningTree.h"
+#include "EdgeChangeBatch.h"
+#include "Kruskal.h"
+
+namespace dgl {
+/**
+ * A fully dynamic minimum spanning forest, maintained in a link-cut tree (with one link-cut node per graph node, and
+ * one per tree edge, holding that edge's weight).
+ *
+ * Enabling an edge costs a single path maximum query: if its endpoints are already connected, it replaces the heaviest
+ * edge on the tree path between them (if it is lighter than that edge). Disabling a non-tree edge costs nothing.
+ * Disabling a tree edge splits its tree in two; the smaller of the two halves is found by searching both halves in
+ * lock step, and the lightest enabled edge leaving that half (if any) reconnects them.
+ *
+ * The changes since the last update are applied as one batch (all deletions, then all insertions). If too many edges
+ * were deleted at once, or any edge weight changed, the forest is rebuilt from scratch with Kruskal's algorithm instead.
+ */
+template<class Status, typename Weight = int>
+class LinkCutMST : public MinimumSpanningTree<Weight>, public DynamicGraphAlgorithm {
+public:
+
+    Graph<Weight>& g;
+    Status& status;
+    const int reportPolarity;
+
+    int last_modification = -1;
+    int history_qhead = 0;
+    int last_history_clear = 0;
+    int alg_id = -1;
+
+    Weight INF = 0;
+    Weight min_weight = 0;
+    int num_sets = 0;
+
+    //node i of the forest is graph node i; node g.nodes()+edgeID stands for that edge, while it is in the tree
+    LinkCutMax<Weight> forest;
+    std::vector<bool> in_tree;
+    alg::Bitset edge_enabled;//the enabled edges, as of the last update
+    EdgeChangeBatch batch;
+
+    DisjointSets sets;
+    std::vector<int> edge_list;
+
+    //used to find the smaller side of a deleted tree edge
+    std::vector<int> visit_stamp;
+    int stamp = 0;
+    std::vector<int> side_u;
+    std::vector<int> side_v;
+
+    //the spanning tree, parents and components are only built on demand
+    bool has_parents = false;
+    bool has_mst = false;
+    std::vector<int> mst;
+    std::vector<int> parents;
+    std::vector<int> parent_edges;
+    std::vector<int> components;
+    std::vector<int> roots;
+    std::vector<int> q;
+
+#ifdef DEBUG_DGL
+    Kruskal<typename MinimumSpanningTree<Weight>::NullStatus, Weight> dbg;
+#endif
+public:
+
+    int64_t num_updates = 0;
+    int64_t stats_full_updates = 0;
+    int64_t stats_fast_updates = 0;
+    int64_t stats_fast_failed_updates = 0;
+    int64_t stats_skipped_deletions = 0;
+    int64_t stats_replacement_searches = 0;
+    int64_t stats_replacement_nodes = 0;
+    double mod_percentage = 0.2;
+
+    LinkCutMST(Graph<Weight>& graph, Status& status, int reportPolarity = 0) :
+            g(graph), status(status), reportPolarity(reportPolarity)
+#ifdef DEBUG_DGL
+    , dbg(g,  MinimumSpanningTree<Weight>::nullStatus, 0)
+#endif
+    {
+        alg_id = g.addDynamicAlgorithm(this);
+    }
+
+    std::string getName() override{
+        return "LinkCutMST";
+    }
+
+    void printStats() override{
+        printf("Updates: %" PRId64 " (%" PRId64 " full, %" PRId64 " incremental, %" PRId64
+               " too large), %" PRId64 " non-tree deletions, %" PRId64 " replacement searches (%" PRId64
+               " nodes searched)\n", num_updates, stats_full_updates, stats_fast_updates, stats_fast_failed_updates,
+               stats_skipped_deletions, stats_replacement_searches, stats_replacement_nodes);
+    }
+
+    int numUpdates() const override{
+        return num_updates;
+    }
+
+    void updateHistory() override{
+        update();
+    }
+
+    void update() override{
+        if(g.outfile()){
+            fprintf(g.outfile(), "m\n");
+            fflush(g.outfile());
+        }
+
+        if(last_modification > 0 && g.getCurrentHistory() == last_modification){
+            return;
+        }
+
+        bool rebuild = last_modification <= 0 || g.changed() || in_tree.size() != g.nEdgeIDs();
+        if(!rebuild){
+            rebuild = !collectChanges();
+            if(!rebuild && batch.deletions.size() > mod_percentage * g.edges()){
+                //each deleted tree edge may require a search for a replacement; past some point, it is cheaper to
+                //rebuild the forest from scratch
+                rebuild = true;
+                stats_fast_failed_updates++;
+            }
+        }
+        has_parents = false;
+        has_mst = false;
+        if(rebuild){
+            recompute();
+        }else{
+            stats_fast_updates++;
+            //Clear all of the deleted edges first, so that none of them can be chosen as a replacement edge
+            for(int edgeID:batch.deletions)
+                edge_enabled.reset(edgeID);
+            for(int edgeID:batch.deletions){
+                if(in_tree[edgeID]){
+                    removeTreeEdge(edgeID);
+                }else{
+                    stats_skipped_deletions++;
+                }
+            }
+            for(int edgeID:batch.insertions){
+                if(!edge_enabled[edgeID]){
+                    edge_enabled.set(edgeID);
+                    insertEdge(edgeID);
+                }
+            }
+        }
+#ifdef DEBUG_DGL
+        assert(min_weight == dbg.forestWeight());
+        assert(num_sets == dbg.numComponents());
+#endif
+        status.setMinimumSpanningTree(num_sets > 1 ? INF : min_weight, num_sets <= 1);
+
+        for(int i = 0; i < in_tree.size(); i++){
+            //Note: for the tree edge detector, polarity is effectively reversed.
+            if(reportPolarity < 1 && (!g.edgeEnabled(i) || in_tree[i])){
+                status.inMinimumSpanningTree(i, true);
+            }else if(reportPolarity > -1 && (g.edgeEnabled(i) && !in_tree[i])){
+                status.inMinimumSpanningTree(i, false);
+            }
+        }
+
+        num_updates++;
+        last_modification = g.getCurrentHistory();
+        history_qhead = g.historySize();
+        last_history_clear = g.nHistoryClears();
+        g.updateAlgorithmHistory(this, alg_id, history_qhead);
+    }
+
+private:
+
+    inline int edgeNode(int edgeID) const{
+        return g.nodes() + edgeID;
+    }
+
+    //Collects the edges enabled and disabled since the last update. Returns false if the forest must be rebuilt.
+    bool collectChanges(){
+        if(last_history_clear != g.nHistoryClears()){
+            if(last_history_clear == g.nHistoryClears() - 1 && g.resumeHistory(history_qhead)){
+                batch.collect(g, history_qhead);
+            }else{
+                //the history since the last update was lost; recover the changes from the edge status instead
+                if(g.lastEdgeIncrease() > last_modification || g.lastEdgeDecrease() > last_modification)
+                    return false;
+                batch.collectDiff(g.getEdgeStatus(), edge_enabled);
+            }
+        }else{
+            batch.collect(g, history_qhead);
+        }
+        return batch.weight_changes.empty();
+    }
+
+    //Kruskal's algorithm
+    void recompute(){
+        stats_full_updates++;
+        batch.clear();
+        int n = g.nodes();
+        INF = 1;
+        for(auto& w : g.getWeights())
+            INF += w;
+        in_tree.clear();
+        in_tree.resize(g.nEdgeIDs(), false);
+        visit_stamp.clear();
+        visit_stamp.resize(n, 0);
+        stamp = 0;
+        forest.reset();
+        while(forest.nNodes() < n + g.nEdgeIDs())
+            forest.addNode();
+        g.getEdgeStatus().copyTo(edge_enabled);
+
+        if(edge_list.size() != g.nEdgeIDs()){
+            edge_list.clear();
+            for(int i = 0; i < g.nEdgeIDs(); i++)
+                edge_list.push_back(i);
+        }
+        std::vector<Weight>& weights = g.getWeights();
+        std::stable_sort(edge_list.begin(), edge_list.end(), [&](int a, int b){
+            return weights[a] < weights[b];
+        });
+
+        sets.Reset();
+        sets.AddElements(n);
+        min_weight = 0;
+        for(int edgeID:edge_list){
+            if(!g.edgeEnabled(edgeID))
+                continue;
+            int u = g.getEdge(edgeID).from;
+            int v = g.getEdge(edgeID).to;
+            int set1 = sets.FindSet(u);
+            int set2 = sets.FindSet(v);
+            if(set1 != set2){
+                sets.UnionSets(set1, set2);
+                linkEdge(edgeID);
+            }
+        }
+        num_sets = sets.NumSets();
+    }
+
+    void linkEdge(int edgeID){
+        int e = edgeNode(edgeID);
+        forest.setValue(e, g.getWeight(edgeID));
+        forest.link(e, g.getEdge(edgeID).from);
+        forest.link(e, g.getEdge(edgeID).to);
+        in_tree[edgeID] = true;
+        min_weight += g.getWeight(edgeID);
+    }
+
+    void cutEdge(int edgeID){
+        int e = edgeNode(edgeID);
+        forest.cut(e, g.getEdge(edgeID).from);
+        forest.cut(e, g.getEdge(edgeID).to);
+        forest.clearValue(e);
+        in_tree[edgeID] = false;
+        min_weight -= g.getWeight(edgeID);
+    }
+
+    void insertEdge(int edgeID){
+        int u = g.getEdge(edgeID).from;
+        int v = g.getEdge(edgeID).to;
+        if(u == v)
+            return;
+        if(!forest.connected(u, v)){
+            linkEdge(edgeID);
+            num_sets--;
+            return;
+        }
+        int heaviest = forest.maxOnPath(u, v);
+        assert(heaviest >= g.nodes());
+        int heaviestEdge = heaviest - g.nodes();
+        if(g.getWeight(heaviestEdge) > g.getWeight(edgeID)){
+            cutEdge(heaviestEdge);
+            linkEdge(edgeID);
+        }
+    }
+
+    //Expands one node of a side of a deleted tree edge. Returns false if that side has no more nodes to visit.
+    bool expand(std::vector<int>& side, int& pos, int mark){
+        if(pos >= side.size())
+            return false;
+        int u = side[pos++];
+        for(int i = 0; i < g.nIncident(u, true); i++){
+            auto& edge = g.incident(u, i, true);
+            if(in_tree[edge.id] && visit_stamp[edge.node] != mark){
+                visit_stamp[edge.node] = mark;
+                side.push_back(edge.node);
+            }
+        }
+        return true;
+    }
+
+    void removeTreeEdge(int edgeID){
+        int u = g.getEdge(edgeID).from;
+        int v = g.getEdge(edgeID).to;
+        cutEdge(edgeID);
+        stats_replacement_searches++;
+
+        //Search the two halves of the tree in lock step, until one of them is exhausted
+        if(stamp >= INT32_MAX - 2){
+            std::fill(visit_stamp.begin(), visit_stamp.end(), 0);
+            stamp = 0;
+        }
+        int mark_u = ++stamp;
+        int mark_v = ++stamp;
+        side_u.clear();
+        side_v.clear();
+        side_u.push_back(u);
+        side_v.push_back(v);
+        visit_stamp[u] = mark_u;
+        visit_stamp[v] = mark_v;
+        int pos_u = 0;
+        int pos_v = 0;
+        std::vector<int>* side = nullptr;
+        int mark = 0;
+        while(true){
+            if(!expand(side_u, pos_u, mark_u)){
+                side = &side_u;
+                mark = mark_u;
+                break;
+            }
+            if(!expand(side_v, pos_v, mark_v)){
+                side = &side_v;
+                mark = mark_v;
+                break;
+            }
+        }
+        stats_replacement_nodes += side_u.size() + side_v.size();
+
+        //The lightest enabled edge leaving the smaller side reconnects the two halves
+        int best = -1;
+        for(int x:*side){
+            for(int i = 0; i < g.nIncident(x, true); i++){
+                auto& edge = g.incident(x, i, true);
+                if(edge_enabled[edge.id] && visit_stamp[edge.node] != mark){
+                    assert(!in_tree[edge.id]);
+                    if(best < 0 || g.getWeight(edge.id) < g.getWeight(best)){
+                        best = edge.id;
+                    }
+                }
+            }
+        }
+        if(best >= 0){
+            linkEdge(best);
+        }else{
+            num_sets++;
+        }
+    }
+
+    void buildParents(){
+        has_parents = true;
+        int n = g.nodes();
+        parents.clear();
+        parents.resize(n, -1);
+        parent_edges.clear();
+        parent_edges.resize(n, -1);
+        components.clear();
+        components.resize(n, -1);
+        roots.clear();
+        for(int root = 0; root < n; root++){
+            if(components[root] >= 0)
+                continue;
+            int c = roots.size();
+            roots.push_back(root);
+            components[root] = c;
+            q.clear();
+            q.push_back(root);
+            while(q.size()){
+                int u = q.back();
+                q.pop_back();
+                for(int i = 0; i < g.nIncident(u, true); i++){
+                    auto& edge = g.incident(u, i, true);
+                    int to = edge.node;
+                    if(in_tree[edge.id] && components[to] < 0){
+                        components[to] = c;
+                        parents[to] = u;
+                        parent_edges[to] = edge.id;
+                        q.push_back(to);
+                    }
+                }
+            }
+        }
+        assert(roots.size() == num_sets);
+    }
+
+public:
+
+    std::vector<int>& getSpanningTree() override{
+        update();
+        if(!has_mst){
+            has_mst = true;
+            mst.clear();
+            for(int i = 0; i < in_tree.size(); i++){
+                if(in_tree[i])
+                    mst.push_back(i);
+            }
+        }
+        return mst;
+    }
+
+    int getParent(int node) override{
+        update();
+        if(!has_parents)
+            buildParents();
+        return parents[node];
+    }
+
+    int getParentEdge(int node) override{
+        if(getParent(node) != -1)
+            return parent_edges[node];
+        else
+            return -1;
+    }
+
+    bool edgeInTree(int edgeid) override{
+        update();
+        return in_tree[edgeid];
+    }
+
+    bool dbg_mst() override{
+        return true;
+    }
+
+    Weight& weight() override{
+        update();
+        assert(dbg_uptodate());
+        if(num_sets <= 1)
+            return min_weight;
+        else
+            return INF;
+    }
+
+    Weight& forestWeight() override{
+        update();
+        assert(dbg_uptodate());
+        return min_weight;
+    }
+
+    int numComponents() override{
+        update();
+        return num_sets;
+    }
+
+    int getComponent(int node) override{
+        update();
+        if(!has_parents)
+            buildParents();
+        return components[node];
+    }
+
+    int getRoot(int component = 0) override{
+        update();
+        if(!has_parents)
+            buildParents();
+        return roots[component];
+    }
+
+    bool dbg_uptodate() override{
+#ifdef DEBUG_DGL
+        Weight sumweight = 0;
+        for(int i = 0; i < in_tree.size(); i++){
+            if(in_tree[i]){
+                assert(g.edgeEnabled(i));
+                sumweight += g.getWeight(i);
+            }
+        }
+        assert(sumweight == min_weight);
+#endif
+        return true;
+    }
+};
+};
+#endif /* LINK_CUT_MST_H_ */
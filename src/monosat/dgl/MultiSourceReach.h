@@ -0,0 +1,332 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MULTISOURCEREACH_H_
+#define MULTISOURCEREACH_H_
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "Graph.h"
+#include "DynamicGraph.h"
+#include "Reach.h"
+
+namespace dgl {
+
+/**
+ * Single-source reachability for many sources at once, over the same graph.
+ * Each node stores one bit per source, packed into 64-bit words, and reachability is propagated for all sources in a
+ * single worklist sweep (each edge ORs the words of its tail into its head), rather than running one traversal per
+ * source. If only edges have been added since the last update, only the newly added edges are propagated.
+ *
+ * Sources are read through MultiSourceReach::Column, which implements the Reach interface for a single source.
+ */
+template<typename Weight, typename Graph = DynamicGraph<Weight>, bool undirected = false>
+class MultiSourceReach {
+public:
+    typedef uint64_t Word;
+    static const int bits_per_word = 64;
+
+    template<class Status>
+    class Column;
+
+private:
+    Graph& g;
+    std::vector<int> sources;//source node of each column
+    int n_words = 0;
+    int n_nodes = 0;
+    std::vector<Word> bits;//n_words words for each node
+    std::vector<int> q;
+    std::vector<char> in_q;
+
+    int last_modification = -1;
+    int last_addition = -1;
+    int last_deletion = -1;
+    int history_qhead = 0;
+    int last_history_clear = 0;
+
+public:
+    int64_t stats_full_updates = 0;
+    int64_t stats_fast_updates = 0;
+    int64_t stats_skipped_updates = 0;
+
+    explicit MultiSourceReach(Graph& graph) : g(graph){
+    }
+
+    //Returns the column that reachability from 's' is reported in. Adding a source forces a full update.
+    int addSource(int s){
+        sources.push_back(s);
+        last_modification = -1;
+        return sources.size() - 1;
+    }
+
+    int nSources() const{
+        return sources.size();
+    }
+
+    int getSource(int column) const{
+        return sources[column];
+    }
+
+    inline bool reaches(int column, int node) const{
+        return node < n_nodes && (bits[(size_t) node * n_words + column / bits_per_word] >> (column % bits_per_word)) & 1;
+    }
+
+    bool upToDate() const{
+        return last_modification == g.getCurrentHistory();
+    }
+
+    int getLastModification() const{
+        return last_modification;
+    }
+
+    void update(){
+        if(last_modification > 0 && g.getCurrentHistory() == last_modification){
+            stats_skipped_updates++;
+            return;
+        }
+        if(g.nHistoryClears() != last_history_clear){
+            last_history_clear = g.nHistoryClears();
+            history_qhead = 0;
+        }else if(last_modification > 0 && last_deletion == g.nDeletions() && n_nodes == g.nodes()
+                 && n_words == (int) (sources.size() + bits_per_word - 1) / bits_per_word){
+            //only additions since the last update: reachability can only grow, so just propagate the new edges
+            stats_fast_updates++;
+            q.clear();
+            for(int i = history_qhead; i < g.historySize(); i++){
+                auto& change = g.getChange(i);
+                if(change.addition && g.edgeEnabled(change.id)){
+                    int from = g.getEdge(change.id).from;
+                    int to = g.getEdge(change.id).to;
+                    pushEdge(from, to);
+                    if(undirected)
+                        pushEdge(to, from);
+                }
+            }
+            propagate();
+            finishUpdate();
+            return;
+        }
+        stats_full_updates++;
+        n_nodes = g.nodes();
+        n_words = (sources.size() + bits_per_word - 1) / bits_per_word;
+        bits.clear();
+        bits.resize((size_t) n_nodes * n_words, 0);
+        in_q.clear();
+        in_q.resize(n_nodes, 0);
+        q.clear();
+        for(int c = 0; c < sources.size(); c++){
+            int s = sources[c];
+            if(s < n_nodes){
+                bits[(size_t) s * n_words + c / bits_per_word] |= ((Word) 1) << (c % bits_per_word);
+                enqueue(s);
+            }
+        }
+        propagate();
+        finishUpdate();
+    }
+
+    void printStats(){
+        printf("Multi-source reach (%d sources): %" PRId64 " full updates, %" PRId64 " fast updates, %" PRId64
+               " skipped updates\n", (int) sources.size(), stats_full_updates, stats_fast_updates,
+               stats_skipped_updates);
+    }
+
+private:
+    inline void enqueue(int u){
+        if(!in_q[u]){
+            in_q[u] = 1;
+            q.push_back(u);
+        }
+    }
+
+    //OR the bits of 'from' into 'to', and enqueue 'to' if it changed.
+    inline void pushEdge(int from, int to){
+        const Word* src = &bits[(size_t) from * n_words];
+        Word* dst = &bits[(size_t) to * n_words];
+        Word changed = 0;
+        for(int w = 0; w < n_words; w++){
+            Word nw = dst[w] | src[w];
+            changed |= nw ^ dst[w];
+            dst[w] = nw;
+        }
+        if(changed)
+            enqueue(to);
+    }
+
+    void propagate(){
+        for(int i = 0; i < q.size(); i++){
+            int u = q[i];
+            in_q[u] = 0;
+            for(int j = 0; j < g.nIncident(u, undirected); j++){
+                auto& edge = g.incident(u, j, undirected);
+                if(g.edgeEnabled(edge.id))
+                    pushEdge(u, edge.node);
+            }
+        }
+        q.clear();
+    }
+
+    void finishUpdate(){
+        last_modification = g.getCurrentHistory();
+        last_deletion = g.nDeletions();
+        last_addition = g.nAdditions();
+        history_qhead = g.historySize();
+        last_history_clear = g.nHistoryClears();
+    }
+};
+
+/**
+ * Reachability from a single source, read from a (shared) MultiSourceReach.
+ * Paths are not tracked by the bit-parallel sweep; when one is requested (through previous() or incomingEdge()),
+ * a BFS restricted to the enabled edges is run from the source, once per graph modification.
+ */
+template<typename Weight, typename Graph, bool undirected>
+template<class Status>
+class MultiSourceReach<Weight, Graph, undirected>::Column : public Reach {
+    MultiSourceReach& reach;
+    Graph& g;
+    Status& status;
+    int column;
+    int source;
+    int reportPolarity;
+    int last_modification = -1;
+    int num_updates = 0;
+    std::vector<int> destinations;
+    std::vector<char> is_destination;
+
+    int path_modification = -1;
+    std::vector<int> prev;
+    std::vector<int> q;
+public:
+    Column(MultiSourceReach& reach, int source, Status& status = Reach::nullStatus, int reportPolarity = 0) :
+            reach(reach), g(reach.g), status(status), source(source), reportPolarity(reportPolarity){
+        column = reach.addSource(source);
+    }
+
+    int numUpdates() const override{
+        return num_updates;
+    }
+
+    void setSource(int s) override{
+        if(s != source){
+            source = s;
+            column = reach.addSource(s);
+            last_modification = -1;
+            path_modification = -1;
+        }
+    }
+
+    int getSource() override{
+        return source;
+    }
+
+    void addDestination(int node) override{
+        if(node >= is_destination.size())
+            is_destination.resize(node + 1, 0);
+        if(!is_destination[node]){
+            is_destination[node] = 1;
+            destinations.push_back(node);
+        }
+    }
+
+    void update() override{
+        if(last_modification > 0 && g.getCurrentHistory() == last_modification){
+            return;
+        }
+        reach.update();
+        //Report the status of the destinations (or of every node, if no destinations were registered)
+        int n = destinations.size() ? destinations.size() : g.nodes();
+        for(int i = 0; i < n; i++){
+            int u = destinations.size() ? destinations[i] : i;
+            bool r = reach.reaches(column, u);
+            if(r ? reportPolarity >= 0 : reportPolarity <= 0)
+                status.setReachable(u, r);
+        }
+        num_updates++;
+        last_modification = g.getCurrentHistory();
+    }
+
+    bool connected_unsafe(int t) override{
+        return reach.reaches(column, t);
+    }
+
+    bool connected_unchecked(int t) override{
+        assert(reach.upToDate());
+        return connected_unsafe(t);
+    }
+
+    bool connected(int t) override{
+        if(!reach.upToDate())
+            reach.update();
+        return reach.reaches(column, t);
+    }
+
+    int incomingEdge(int t) override{
+        updatePaths();
+        assert(t >= 0 && t < prev.size());
+        return prev[t];
+    }
+
+    int previous(int t) override{
+        int edgeID = incomingEdge(t);
+        if(edgeID < 0)
+            return -1;
+        if(undirected && g.getEdge(edgeID).from == t){
+            return g.getEdge(edgeID).to;
+        }
+        assert(g.getEdge(edgeID).to == t);
+        return g.getEdge(edgeID).from;
+    }
+
+    void printStats() override{
+        reach.printStats();
+    }
+
+private:
+    void updatePaths(){
+        if(path_modification == g.getCurrentHistory())
+            return;
+        path_modification = g.getCurrentHistory();
+        prev.clear();
+        prev.resize(g.nodes(), -1);
+        q.clear();
+        if(source >= g.nodes())
+            return;
+        prev[source] = -2;//marks the source as visited
+        q.push_back(source);
+        for(int i = 0; i < q.size(); i++){
+            int u = q[i];
+            for(int j = 0; j < g.nIncident(u, undirected); j++){
+                auto& edge = g.incident(u, j, undirected);
+                if(g.edgeEnabled(edge.id) && prev[edge.node] == -1){
+                    prev[edge.node] = edge.id;
+                    q.push_back(edge.node);
+                }
+            }
+        }
+        prev[source] = -1;
+    }
+};
+};
+
+#endif /* MULTISOURCEREACH_H_ */
@@ -886,9 +886,8 @@ public:
 
             if(last_history_clear != g.nHistoryClears()){
                 if(!g.changed() && last_history_clear >= 0 && last_history_clear == g.nHistoryClears() - 1 &&
-                   history_qhead == g.getPreviousHistorySize()){
-                    //no information was lost in the history clear
-                    history_qhead = 0;
+                   g.resumeHistory(history_qhead)){
+                    //no information was lost in the history clear (or it was carried over)
                     last_history_clear = g.nHistoryClears();
                 }else{
                     history_qhead = g.historySize();
@@ -1241,6 +1240,7 @@ public:
     std::vector<int> edgeInShortestPathGraph;
     std::vector<int> delta;
     std::vector<int> changeset;
+    alg::Bitset edge_enabled;//the enabled edges, as of the last update
     int alg_id = -1;
 public:
 
@@ -1913,10 +1913,22 @@ public:
 
         if(last_history_clear != g.nHistoryClears()){
             if(!g.changed() && last_history_clear >= 0 && last_history_clear == g.nHistoryClears() - 1 &&
-               history_qhead == g.getPreviousHistorySize()){
-                //no information was lost in the history clear
-                history_qhead = 0;
+               g.resumeHistory(history_qhead)){
+                //no information was lost in the history clear (or it was carried over)
                 last_history_clear = g.nHistoryClears();
+            }else if(last_history_clear >= 0){
+                //The history since the last update was lost, but the edges that changed since then are exactly
+                //those whose status differs from the snapshot taken at the last update.
+                history_qhead = g.historySize();
+                last_history_clear = g.nHistoryClears();
+                g.getEdgeStatus().forEachDiff(edge_enabled, [&](int edgeid, bool enabled){
+                    if(enabled){
+                        AddEdge(edgeid);
+                    }else{
+                        RemoveEdge(edgeid);
+                    }
+                });
+                g.getEdgeStatus().copyTo(edge_enabled);
             }else{
                 history_qhead = g.historySize();
                 last_history_clear = g.nHistoryClears();
@@ -1927,9 +1939,11 @@ public:
                         RemoveEdge(edgeid);
                     }
                 }
+                g.getEdgeStatus().copyTo(edge_enabled);
             }
         }
-
+        if(edge_enabled.size() < g.nEdgeIDs())
+            edge_enabled.resize(g.nEdgeIDs());
         for(int i = history_qhead; i < g.historySize(); i++){
             int edgeid = g.getChange(i).id;
             if(g.getChange(i).addition && g.edgeEnabled(edgeid)){
@@ -1937,6 +1951,7 @@ public:
             }else if(!g.getChange(i).addition && !g.edgeEnabled(edgeid)){
                 RemoveEdge(edgeid);
             }
+            edge_enabled.set(edgeid, g.edgeEnabled(edgeid));
         }
 
         for(int u : changed){
@@ -575,9 +575,8 @@ public:
 
             if(last_history_clear != g.nHistoryClears()){
                 if(!g.changed() && last_history_clear >= 0 && last_history_clear == g.nHistoryClears() - 1 &&
-                   history_qhead == g.getPreviousHistorySize()){
-                    //no information was lost in the history clear
-                    history_qhead = 0;
+                   g.resumeHistory(history_qhead)){
+                    //no information was lost in the history clear (or it was carried over)
                     last_history_clear = g.nHistoryClears();
                 }else{
                     history_qhead = g.historySize();
@@ -1699,9 +1698,8 @@ public:
 
         if(last_history_clear != g.nHistoryClears()){
             if(!g.changed() && last_history_clear >= 0 && last_history_clear == g.nHistoryClears() - 1 &&
-               history_qhead == g.getPreviousHistorySize()){
-                //no information was lost in the history clear
-                history_qhead = 0;
+               g.resumeHistory(history_qhead)){
+                //no information was lost in the history clear (or it was carried over)
                 last_history_clear = g.nHistoryClears();
             }else{
                 history_qhead = g.historySize();
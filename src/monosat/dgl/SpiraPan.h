@@ -29,6 +29,7 @@
 #include "monosat/core/Config.h"
 #include "MinimumSpanningTree.h"
 #include "Kruskal.h"
+#include "EdgeChangeBatch.h"
 #include <algorithm>
 #include <limits>
 #include <iostream>
@@ -71,7 +72,8 @@ public:
     std::vector<bool> component_needs_visit;
     std::vector<int> component_member; //pointer to one arbitrary member of each non-empty component
     std::vector<Weight> component_edge_weight;
-    std::vector<bool> edge_enabled;
+    alg::Bitset edge_enabled;//the enabled edges, as of the last update
+    EdgeChangeBatch batch;
 
     struct VertLt {
         const std::vector<Weight>& keys;
@@ -630,18 +632,31 @@ public:
         }
 
         assert(components_to_visit.size() == 0);
-        if(last_modification <= 0 || g.changed() || last_history_clear != g.nHistoryClears()){
+        bool rebuild = last_modification <= 0 || g.changed();
+        if(!rebuild){
+            if(last_history_clear != g.nHistoryClears()){
+                //The history since the last update was lost; the edges that changed since then are exactly those
+                //whose status differs from edge_enabled, so apply just those changes rather than rebuilding the tree.
+                batch.collectDiff(g.getEdgeStatus(), edge_enabled);
+            }else{
+                batch.collect(g, history_qhead);
+            }
+            //Each deleted tree edge requires a search for a replacement edge; once a large enough fraction of the
+            //edges have been deleted, it is cheaper to rebuild the whole tree with Prim's.
+            if(batch.deletions.size() > mod_percentage * g.edges()){
+                rebuild = true;
+                stats_fast_failed_updates++;
+            }
+        }
+        if(rebuild){
+            stats_full_updates++;
+            batch.clear();
             INF = 1;                //g.nodes()+1;
             setNodes(g.nodes());
 
             for(auto& w : g.getWeights())
                 INF += w;
-            edge_enabled.clear();
-            edge_enabled.resize(g.edges());
-            for(int i = 0; i < g.edges(); i++)
-                if(g.hasEdge(i) && g.edgeEnabled(i)){
-                    edge_enabled[i] = true;//this can be improved (see Kohli-Torr!)
-                }
+            g.getEdgeStatus().copyTo(edge_enabled);
             seen.clear();
             seen.resize(g.nodes());
             min_weight = 0;
@@ -681,17 +696,22 @@ public:
             min_weight = 0;
 
         }else{
-            for(int i = history_qhead; i < g.historySize(); i++){
-
-                int edgeid = g.getChange(i).id;
-                if(g.getChange(i).addition && g.edgeEnabled(edgeid) && !edge_enabled[edgeid]){
+            if(!rebuild)
+                stats_fast_updates++;
+            //Apply all of the deletions before any of the insertions, so that the first call to prims() below
+            //reconnects the components separated by the deletions once, rather than once per interleaved deletion.
+            for(int edgeid:batch.deletions){
+                if(edge_enabled[edgeid]){
+                    removeEdgeFromMST(edgeid);
+                    edge_enabled.reset(edgeid);
+                }
+            }
+            for(int edgeid:batch.insertions){
+                if(!edge_enabled[edgeid]){
                     prims();//to maintain correctness in spirapan, prims apparently must be called before addEdgeToMST.
                     //however, the current implementation can likely be improved by only running prims on the components of the endpoints of edgeid...
-                    edge_enabled[edgeid] = true;
+                    edge_enabled.set(edgeid);
                     addEdgeToMST(edgeid);
-                }else if(!g.getChange(i).addition && !g.edgeEnabled(edgeid) && edge_enabled[edgeid]){
-                    removeEdgeFromMST(edgeid);
-                    edge_enabled[edgeid] = false;
                 }
             }
 #ifdef DEBUG_DGL
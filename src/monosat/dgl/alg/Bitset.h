@@ -0,0 +1,189 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+//A bit vector packed into 64-bit words, with word-level bulk operations (population count, iteration over set bits,
+//and iteration over the bits that differ from another bitset).
+#ifndef DGL_Bitset_h
+#define DGL_Bitset_h
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace dgl {
+namespace alg {
+
+class Bitset {
+public:
+    typedef uint64_t Word;
+    static const int bits_per_word = 64;
+private:
+    std::vector<Word> words;
+    int sz = 0;
+
+    static inline int popcount(Word w){
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(w);
+#else
+        w = w - ((w >> 1) & 0x5555555555555555ULL);
+        w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+        return (int) ((((w + (w >> 4)) & 0xF0F0F0F0F0F0F0FULL) * 0x101010101010101ULL) >> 56);
+#endif
+    }
+
+    //Index of the lowest set bit of a non-zero word
+    static inline int lowestBit(Word w){
+        assert(w);
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(w);
+#else
+        int p = 0;
+        while(!(w & 1)){
+            w >>= 1;
+            p++;
+        }
+        return p;
+#endif
+    }
+
+public:
+    Bitset(){}
+
+    explicit Bitset(int size, bool value = false){
+        resize(size, value);
+    }
+
+    int size() const{
+        return sz;
+    }
+
+    int nWords() const{
+        return words.size();
+    }
+
+    //The i'th word; bits past size() are always 0.
+    inline Word word(int i) const{
+        return words[i];
+    }
+
+    void resize(int size, bool value = false){
+        int old_sz = sz;
+        sz = size;
+        words.resize((size + bits_per_word - 1) / bits_per_word, value ? ~((Word) 0) : 0);
+        if(value && size > old_sz && old_sz % bits_per_word){
+            //set the tail of the previously last word
+            words[old_sz / bits_per_word] |= ~((Word) 0) << (old_sz % bits_per_word);
+        }
+        if(sz % bits_per_word){
+            words.back() &= (((Word) 1) << (sz % bits_per_word)) - 1;
+        }
+    }
+
+    void clear(){
+        words.clear();
+        sz = 0;
+    }
+
+    inline bool operator[](int i) const{
+        assert(i >= 0 && i < sz);
+        return (words[i / bits_per_word] >> (i % bits_per_word)) & 1;
+    }
+
+    inline void set(int i){
+        assert(i >= 0 && i < sz);
+        words[i / bits_per_word] |= ((Word) 1) << (i % bits_per_word);
+    }
+
+    inline void reset(int i){
+        assert(i >= 0 && i < sz);
+        words[i / bits_per_word] &= ~(((Word) 1) << (i % bits_per_word));
+    }
+
+    inline void set(int i, bool value){
+        if(value)
+            set(i);
+        else
+            reset(i);
+    }
+
+    //Number of set bits
+    int count() const{
+        int n = 0;
+        for(Word w:words)
+            n += popcount(w);
+        return n;
+    }
+
+    //Number of bits that differ from 'other' (bits past the end of the shorter bitset count as 0)
+    int countDiff(const Bitset& other) const{
+        int n = 0;
+        int common = words.size() < other.words.size() ? words.size() : other.words.size();
+        for(int i = 0; i < common; i++)
+            n += popcount(words[i] ^ other.words[i]);
+        for(int i = common; i < words.size(); i++)
+            n += popcount(words[i]);
+        for(int i = common; i < other.words.size(); i++)
+            n += popcount(other.words[i]);
+        return n;
+    }
+
+    //Calls f(index) for each set bit, in increasing order of index.
+    template<class F>
+    void forEachSet(F f) const{
+        for(int i = 0; i < words.size(); i++){
+            Word w = words[i];
+            while(w){
+                f(i * bits_per_word + lowestBit(w));
+                w &= w - 1;
+            }
+        }
+    }
+
+    //Calls f(index, value) for each bit whose value differs from the same bit of 'previous' (a snapshot of this
+    //bitset, taken earlier), in increasing order of index. Bits past the end of 'previous' are treated as 0.
+    //Only the words that differ are examined bit by bit.
+    template<class F>
+    void forEachDiff(const Bitset& previous, F f) const{
+        for(int i = 0; i < words.size(); i++){
+            Word cur = words[i];
+            Word diff = cur ^ (i < previous.words.size() ? previous.words[i] : 0);
+            while(diff){
+                int b = lowestBit(diff);
+                f(i * bits_per_word + b, (bool) ((cur >> b) & 1));
+                diff &= diff - 1;
+            }
+        }
+    }
+
+    void copyTo(Bitset& to) const{
+        to.words = words;
+        to.sz = sz;
+    }
+
+    void swap(Bitset& other){
+        words.swap(other.words);
+        std::swap(sz, other.sz);
+    }
+};
+}
+}
+
+#endif
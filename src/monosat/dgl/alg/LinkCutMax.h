@@ -0,0 +1,228 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef LINK_CUT_MAX
+#define LINK_CUT_MAX
+
+#include <cassert>
+#include <vector>
+#include <utility>
+
+//Link-Cut Tree over unrooted trees, augmented to find the node of maximum value on the path between two nodes.
+//Like LinkCut.h, this is based on Sleator and Tarjan's splay tree representation, but it additionally supports
+//re-rooting a tree (by lazily reversing the splay tree of the exposed path), so that any two nodes in different trees
+//can be linked, and any tree edge can be cut.
+//
+//Only some nodes carry a value (see setValue()); nodes without a value are ignored by maxOnPath(). To find the
+//maximum weight edge on a path in a forest, represent each edge by its own node, with the edge's weight, between its
+//two (valueless) endpoints.
+template<typename Weight>
+class LinkCutMax {
+    struct Node {
+        int left = -1;
+        int right = -1;
+        int parent = -1;
+        int max = -1;//the node with the largest value in this node's splay subtree, or -1
+        bool reversed = false;
+        bool hasValue = false;
+        Weight value = Weight();
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> stack;
+
+    bool isRoot(int x) const{
+        int p = nodes[x].parent;
+        return p == -1 || (nodes[p].left != x && nodes[p].right != x);
+    }
+
+    //Returns whichever of a, b has the larger value (or the one that has a value at all)
+    int larger(int a, int b) const{
+        if(a == -1)
+            return b;
+        if(b == -1)
+            return a;
+        return nodes[b].value > nodes[a].value ? b : a;
+    }
+
+    void pull(int x){
+        Node& n = nodes[x];
+        int m = n.hasValue ? x : -1;
+        if(n.left != -1)
+            m = larger(m, nodes[n.left].max);
+        if(n.right != -1)
+            m = larger(m, nodes[n.right].max);
+        n.max = m;
+    }
+
+    void push(int x){
+        Node& n = nodes[x];
+        if(n.reversed){
+            std::swap(n.left, n.right);
+            if(n.left != -1)
+                nodes[n.left].reversed = !nodes[n.left].reversed;
+            if(n.right != -1)
+                nodes[n.right].reversed = !nodes[n.right].reversed;
+            n.reversed = false;
+        }
+    }
+
+    void rotate(int x){
+        int p = nodes[x].parent;
+        int g = nodes[p].parent;
+        bool pRoot = isRoot(p);
+        if(nodes[p].left == x){
+            nodes[p].left = nodes[x].right;
+            if(nodes[p].left != -1)
+                nodes[nodes[p].left].parent = p;
+            nodes[x].right = p;
+        }else{
+            nodes[p].right = nodes[x].left;
+            if(nodes[p].right != -1)
+                nodes[nodes[p].right].parent = p;
+            nodes[x].left = p;
+        }
+        nodes[p].parent = x;
+        nodes[x].parent = g;
+        if(!pRoot){
+            if(nodes[g].left == p)
+                nodes[g].left = x;
+            else
+                nodes[g].right = x;
+        }
+        pull(p);
+        pull(x);
+    }
+
+    void splay(int x){
+        //push any pending reversals down from the root of x's splay tree first
+        stack.clear();
+        for(int y = x;; y = nodes[y].parent){
+            stack.push_back(y);
+            if(isRoot(y))
+                break;
+        }
+        for(int i = stack.size() - 1; i >= 0; i--)
+            push(stack[i]);
+
+        while(!isRoot(x)){
+            int p = nodes[x].parent;
+            if(!isRoot(p)){
+                int g = nodes[p].parent;
+                bool zigzig = (nodes[g].left == p) == (nodes[p].left == x);
+                rotate(zigzig ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    //Makes the path from x to the root of its tree preferred, with x as the root of its splay tree
+    void access(int x){
+        int last = -1;
+        for(int y = x; y != -1; y = nodes[y].parent){
+            splay(y);
+            nodes[y].right = last;
+            pull(y);
+            last = y;
+        }
+        splay(x);
+    }
+
+    void makeRoot(int x){
+        access(x);
+        nodes[x].reversed = !nodes[x].reversed;
+    }
+
+public:
+
+    int addNode(){
+        nodes.emplace_back();
+        return nodes.size() - 1;
+    }
+
+    int nNodes() const{
+        return nodes.size();
+    }
+
+    void setValue(int x, const Weight& value){
+        access(x);
+        nodes[x].hasValue = true;
+        nodes[x].value = value;
+        pull(x);
+    }
+
+    void clearValue(int x){
+        access(x);
+        nodes[x].hasValue = false;
+        pull(x);
+    }
+
+    int findRoot(int x){
+        access(x);
+        push(x);
+        while(nodes[x].left != -1){
+            x = nodes[x].left;
+            push(x);
+        }
+        splay(x);
+        return x;
+    }
+
+    bool connected(int x, int y){
+        if(x == y)
+            return true;
+        return findRoot(x) == findRoot(y);
+    }
+
+    //prerequisite: x and y are in distinct trees
+    void link(int x, int y){
+        assert(!connected(x, y));
+        makeRoot(x);
+        nodes[x].parent = y;
+    }
+
+    //prerequisite: x and y are adjacent in the same tree
+    void cut(int x, int y){
+        makeRoot(x);
+        access(y);
+        assert(nodes[y].left == x && nodes[x].right == -1);
+        nodes[y].left = -1;
+        nodes[x].parent = -1;
+        pull(y);
+    }
+
+    //Returns the node with the largest value on the path from x to y (inclusive), or -1 if no node on that path has a
+    //value. x and y must be connected.
+    int maxOnPath(int x, int y){
+        assert(connected(x, y));
+        makeRoot(x);
+        access(y);
+        return nodes[y].max;
+    }
+
+    //Disconnects all the nodes, and clears their values
+    void reset(){
+        for(Node& n:nodes)
+            n = Node();
+    }
+};
+
+#endif
@@ -108,6 +108,13 @@ public:
         return propagate(conflict);
     }
 
+    //Bring this detector's dynamic graph algorithms up to date with the current graph, without propagating anything.
+    //This may be called concurrently for different detectors (see -graph-prop-threads), so implementations may only
+    //modify state owned by this detector. propagate() must still be correct if this was not called first.
+    virtual void preparePropagation(){
+
+    }
+
     virtual void activateHeuristic(){
 
     }
@@ -110,7 +110,8 @@ DistanceDetector<Weight, Graph>::DistanceDetector(int _detectorID, GraphTheorySo
                                                                                                     0);
         }
 
-    }else if(distalg == DistAlg::ALG_RAMAL_REPS){
+    }else if(distalg == DistAlg::ALG_RAMAL_REPS || distalg == DistAlg::ALG_EVEN_SHILOACH){
+        //(the Even-Shiloach trees are only used for weighted distances)
         if(!opt_encode_dist_underapprox_as_sat){
             underapprox_unweighted_distance_detector = new UnweightedRamalReps<Weight, Graph,
                     typename DistanceDetector<Weight, Graph>::ReachStatus>(from, g_under, *(positiveReachStatus), 0);
@@ -472,8 +473,12 @@ DistanceDetector<Weight, Graph>::addUnweightedShortestPathLit(int from, int to,
     if(within_steps > max_unweighted_distance){
         max_unweighted_distance = within_steps;
         if(opt_compute_max_distance){
-            underapprox_unweighted_distance_detector->setMaxDistance(max_unweighted_distance);
-            overapprox_unweighted_distance_detector->setMaxDistance(max_unweighted_distance);
+            //Only nodes within the largest distance constrained from this source matter, so the searches can stop
+            //there (and are extended if a constraint with a larger distance is added later).
+            if(underapprox_unweighted_distance_detector)
+                underapprox_unweighted_distance_detector->setMaxDistance(max_unweighted_distance);
+            if(overapprox_unweighted_distance_detector)
+                overapprox_unweighted_distance_detector->setMaxDistance(max_unweighted_distance);
         }
     }
 
@@ -754,6 +759,19 @@ void DistanceDetector<Weight, Graph>::preprocess(){
 }
 
 
+template<typename Weight, typename Graph>
+void DistanceDetector<Weight, Graph>::preparePropagation(){
+    //As in propagate(); the distance status callbacks only record changed nodes in this detector.
+    if(!underapprox_unweighted_distance_detector)
+        return;
+    if(!opt_detect_pure_theory_lits || unassigned_positives > 0){
+        underapprox_unweighted_distance_detector->update();
+    }
+    if(!opt_detect_pure_theory_lits || unassigned_negatives > 0){
+        overapprox_unweighted_distance_detector->update();
+    }
+}
+
 template<typename Weight, typename Graph>
 bool DistanceDetector<Weight, Graph>::propagate(vec<Lit>& conflict){
     if(!underapprox_unweighted_distance_detector)
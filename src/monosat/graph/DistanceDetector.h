@@ -214,6 +214,8 @@ public:
 
     bool propagate(vec<Lit>& conflict) override;
 
+    void preparePropagation() override;
+
     void buildUnweightedDistanceLEQReason(int node, vec<Lit>& conflict);
 
     void buildUnweightedDistanceGTReason(int node, int within_steps, vec<Lit>& conflict);
@@ -23,6 +23,7 @@
 #define GRAPH_THEORY_H_
 
 #include "monosat/utils/System.h"
+#include "monosat/utils/ThreadPool.h"
 #include "monosat/core/Theory.h"
 #include "monosat/core/Config.h"
 #include "monosat/dgl/Reach.h"
@@ -481,6 +482,19 @@ public:
     vec<Detector*> detectors;
     vec<ReachDetector<Weight>*> reach_detectors;
     vec<ReachDetector<Weight, DynamicBackGraph<Weight>>*> reach_back_detectors;
+    //Reachability engines shared by all reach detectors (one bit per source), with the multisource reach algorithm
+    MultiSourceReach<Weight>* shared_reach_under = nullptr;
+    MultiSourceReach<Weight>* shared_reach_over = nullptr;
+    MultiSourceReach<Weight, DynamicBackGraph<Weight>>* shared_reach_under_back = nullptr;
+    MultiSourceReach<Weight, DynamicBackGraph<Weight>>* shared_reach_over_back = nullptr;
+    //Compressed adjacency snapshots traversed by the bfs reach detectors, with -graph-csr
+    CSRGraph<Weight>* csr_under = nullptr;
+    CSRGraph<Weight>* csr_over = nullptr;
+    CSRGraph<Weight, DynamicBackGraph<Weight>>* csr_under_back = nullptr;
+    CSRGraph<Weight, DynamicBackGraph<Weight>>* csr_over_back = nullptr;
+    //Workers that update the detectors' dynamic algorithms concurrently, with -graph-prop-threads
+    ThreadPool* prop_pool = nullptr;
+    vec<Detector*> prepare_detectors;
     vec<DistanceDetector<Weight>*> distance_detectors;
     vec<DistanceDetector<Weight, DynamicBackGraph<Weight>>*> distance_back_detectors;
     vec<WeightedDistanceDetector<Weight>*> weighted_distance_detectors;
@@ -600,6 +614,8 @@ public:
     int64_t stats_pure_skipped = 0;
     int64_t stats_mc_calls = 0;
     int64_t stats_propagations_skipped = 0;
+    int64_t stats_parallel_prepares = 0;
+    double stats_parallel_prepare_time = 0;
 
     int64_t stats_lazy_decisions = 0;
     vec<Lit> reach_cut;
@@ -654,6 +670,15 @@ public:
         return "Graph";
     }
 
+    //Edge literals dominate the search space of most graph problems, so they are the preferred splitting literals.
+    void getSplittingLits(vec<Lit>& out) override{
+        for(int i = 0; i < edge_list.size(); i++){
+            if(edge_list[i].v >= 0){
+                out.push(mkLit(toSolver(edge_list[i].v)));
+            }
+        }
+    }
+
     //A bitwidth of -2 means that the graph will detect the bitwidth
     //itself, based on the edges added to it.
     //A bitwidth of -1 means: constant weight, non-bitvector edges.
@@ -756,9 +781,16 @@ public:
         printf("Skipped History Clears: over_approx %" PRId64 ", under_approx %" PRId64 ", cut_graph %" PRId64 "\n",
                g_over.skipped_historyclears,
                g_under.skipped_historyclears, cutGraph.skipped_historyclears);
+        printf("Resumed after History Clears: over_approx %" PRId64 ", under_approx %" PRId64 ", cut_graph %" PRId64 "\n",
+               g_over.carried_resumes,
+               g_under.carried_resumes, cutGraph.carried_resumes);
         printf("Propagations: %" PRId64 " (%f s, avg: %f s, %" PRId64 " skipped)\n", stats_propagations,
                propagationtime,
                (propagationtime) / ((double) stats_propagations + 1), stats_propagations_skipped);
+        if(stats_parallel_prepares > 0){
+            printf("Parallel detector updates: %" PRId64 " (%f s, %d threads)\n", stats_parallel_prepares,
+                   stats_parallel_prepare_time, prop_pool->nThreads());
+        }
         printf("Decisions: %" PRId64 " (%f s, avg: %f s), lazy decisions: %" PRId64 "\n", stats_decisions,
                stats_decision_time,
                (stats_decision_time) / ((double) stats_decisions + 1), stats_lazy_decisions);
@@ -1282,7 +1314,15 @@ public:
     };
 
     ~GraphTheorySolver() override{
-
+        delete shared_reach_under;
+        delete shared_reach_over;
+        delete shared_reach_under_back;
+        delete shared_reach_over_back;
+        delete csr_under;
+        delete csr_over;
+        delete csr_under_back;
+        delete csr_over_back;
+        delete prop_pool;
     }
 
     void setNodeName(int node, const std::string& symbol){
@@ -2367,6 +2407,52 @@ public:
     }
 
 
+    /**
+     * Updates the dynamic algorithms of all unsatisfied detectors concurrently, before they are propagated.
+     * The detectors are still propagated sequentially, in detector order, so the conflicts and implied literals
+     * do not depend on the number of threads or on how the updates were scheduled.
+     * State that is shared between detectors and updated lazily is brought up to date first, so that the
+     * detectors only read it concurrently.
+     */
+    void prepareDetectors(){
+        prepare_detectors.clear();
+        for(int d = 0; d < detectors.size(); d++){
+            if(!satisfied_detectors[d])
+                prepare_detectors.push(detectors[d]);
+        }
+        if(prepare_detectors.size() < 2)
+            return;
+        double start_time = rtime(1);
+        g_under_back.getEdges();
+        g_over_back.getEdges();
+        g_under_weights_over_back.getEdges();
+        g_over_weights_under_back.getEdges();
+        if(shared_reach_under){
+            shared_reach_under->update();
+            shared_reach_over->update();
+        }
+        if(shared_reach_under_back){
+            shared_reach_under_back->update();
+            shared_reach_over_back->update();
+        }
+        if(csr_under){
+            csr_under->freeze();
+            csr_over->freeze();
+        }
+        if(csr_under_back){
+            csr_under_back->freeze();
+            csr_over_back->freeze();
+        }
+        if(!prop_pool){
+            prop_pool = new ThreadPool(opt_graph_prop_threads);
+        }
+        prop_pool->parallelFor(prepare_detectors.size(), [&](int i){
+            prepare_detectors[i]->preparePropagation();
+        });
+        stats_parallel_prepares++;
+        stats_parallel_prepare_time += rtime(1) - start_time;
+    }
+
     bool propagateTheory(vec<Lit>& conflict, bool force_propagation){
         dbg_check_trails();
         conflictingHeuristic = this;
@@ -2441,6 +2527,10 @@ public:
 
         assert(dbg_graphsUpToDate());
 
+        if(opt_graph_prop_threads > 1){
+            prepareDetectors();
+        }
+
         for(int d = 0; d < detectors.size(); d++){
             if(satisfied_detectors[d])
                 continue;
@@ -3549,10 +3639,18 @@ public:
             within_steps = -1;
         if(!backward){
             if(reach_info[from].source < 0){
-
+                if(reachalg == ReachAlg::ALG_MULTISOURCE && !shared_reach_under){
+                    shared_reach_under = new MultiSourceReach<Weight>(g_under);
+                    shared_reach_over = new MultiSourceReach<Weight>(g_over);
+                }
+                if(reachalg == ReachAlg::ALG_BFS && opt_graph_csr && !csr_under){
+                    csr_under = new CSRGraph<Weight>(g_under);
+                    csr_over = new CSRGraph<Weight>(g_over);
+                }
                 ReachDetector<Weight>* rd = new ReachDetector<Weight>(detectors.size(), this, g_under, g_over, cutGraph,
                                                                       from,
-                                                                      drand(rnd_seed));
+                                                                      drand(rnd_seed), shared_reach_under,
+                                                                      shared_reach_over, csr_under, csr_over);
                 addDetector(rd);
                 reach_detectors.push(rd);
 
@@ -3570,9 +3668,17 @@ public:
             d->addLit(from, to, reach_var);
         }else{
             if(backward_reach_info[from].source < 0){
-
+                if(reachalg == ReachAlg::ALG_MULTISOURCE && !shared_reach_under_back){
+                    shared_reach_under_back = new MultiSourceReach<Weight, DynamicBackGraph<Weight>>(g_under_back);
+                    shared_reach_over_back = new MultiSourceReach<Weight, DynamicBackGraph<Weight>>(g_over_back);
+                }
+                if(reachalg == ReachAlg::ALG_BFS && opt_graph_csr && !csr_under_back){
+                    csr_under_back = new CSRGraph<Weight, DynamicBackGraph<Weight>>(g_under_back);
+                    csr_over_back = new CSRGraph<Weight, DynamicBackGraph<Weight>>(g_over_back);
+                }
                 ReachDetector<Weight, DynamicBackGraph<Weight>>* rd = new ReachDetector<Weight, DynamicBackGraph<Weight>>
-                        (detectors.size(), this, g_under_back, g_over_back, cutGraph_back, from, drand(rnd_seed));
+                        (detectors.size(), this, g_under_back, g_over_back, cutGraph_back, from, drand(rnd_seed),
+                         shared_reach_under_back, shared_reach_over_back, csr_under_back, csr_over_back);
                 addDetector(rd);
                 reach_back_detectors.push(rd);
 
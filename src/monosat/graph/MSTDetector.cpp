@@ -22,6 +22,7 @@
 #include "GraphTheory.h"
 #include "monosat/dgl/Prim.h"
 #include "monosat/dgl/SpiraPan.h"
+#include "monosat/dgl/LinkCutMST.h"
 
 #include <set>
 
@@ -68,6 +69,16 @@ MSTDetector<Weight, Graph>::MSTDetector(int detectorID, GraphTheorySolver<Weight
         overapprox_conflict_detector = new Kruskal<typename MinimumSpanningTree<Weight>::NullStatus, Weight>(antig,
                                                                                                              MinimumSpanningTree<Weight>::nullStatus,
                                                                                                              -1);
+    }else if(mstalg == MinSpanAlg::ALG_LINK_CUT){
+        underapprox_detector = new LinkCutMST<MSTDetector<Weight, Graph>::MSTStatus, Weight>(g,
+                                                                                             *(positiveReachStatus),
+                                                                                             1);
+        overapprox_detector = new LinkCutMST<MSTDetector<Weight, Graph>::MSTStatus, Weight>(antig,
+                                                                                            *(negativeReachStatus), -1);
+        //The link-cut forest is kept up to date incrementally, so (as with Kruskal's) the same instances are also used
+        //for conflict analysis, rather than recomputing a separate spanning tree from scratch.
+        underapprox_conflict_detector = underapprox_detector;
+        overapprox_conflict_detector = overapprox_detector;
     }
 
     underprop_marker = outer->newReasonMarker(getID());
@@ -423,6 +423,8 @@ void MaxflowDetector<Weight, Graph>::analyzeMaxFlowLEQ(Weight flow, vec<Lit>& co
     if(force_maxflow || opt_conflict_min_cut_maxflow){
         Weight foundflow = overapprox_conflict_detector->maxFlow();
         collectChangedEdges();
+        if(findCachedCut(foundflow, conflict))
+            return;
         collectDisabledEdges();
         //g_over.drawFull(true);
         //learn_graph.drawFull(true);
@@ -479,6 +481,7 @@ void MaxflowDetector<Weight, Graph>::analyzeMaxFlowLEQ(Weight flow, vec<Lit>& co
 
          }*/
 
+        cut_edges.clear();
         if(f < 0x0FF0F0){
             assert(f < 0x0FF0F0);
             for(int i = 0; i < cut.size(); i++){
@@ -489,6 +492,7 @@ void MaxflowDetector<Weight, Graph>::analyzeMaxFlowLEQ(Weight flow, vec<Lit>& co
                 if(outer->value(l) == l_False){//it is possible for the edge to be enabled, but to be set to capacity 0.
                     bassert(outer->value(l) == l_False);
                     conflict.push(outer->toSolver(l));
+                    cut_edges.push_back(edgeID);
 
                 }else if(outer->hasBitVector(edgeID) && !outer->getEdgeBV(edgeID).isConst()){
                     Weight residual = overapprox_conflict_detector->getEdgeResidualCapacity(edgeID);
@@ -505,7 +509,7 @@ void MaxflowDetector<Weight, Graph>::analyzeMaxFlowLEQ(Weight flow, vec<Lit>& co
         }else{
             //there is no way to increase the max flow.
         }
-
+        cacheCut(foundflow);
         return;
     }
 
@@ -624,6 +628,68 @@ void MaxflowDetector<Weight, Graph>::analyzeMaxFlowLEQ(Weight flow, vec<Lit>& co
 #endif
 }
 
+/**
+ * Looks for a recently learnt min-cut whose edges are all still disabled, and whose flow is no greater than 'flow'
+ * (the current maximum flow in the over-approximate graph). If one is found, its edges are a valid explanation for
+ * the maximum flow being too low, and are added to the conflict (without computing a new min-cut).
+ */
+template<typename Weight, typename Graph>
+bool MaxflowDetector<Weight, Graph>::findCachedCut(Weight flow, vec<Lit>& conflict){
+    if(opt_conflict_min_cut_cache <= 0 || outer->hasBitVectorEdges())
+        return false;
+    if(cut_cache_edges != g_over.edges()){
+        //new edges may cross the cached cuts
+        cut_cache.clear();
+        cut_cache_next = 0;
+        cut_cache_edges = g_over.edges();
+    }
+    int best = -1;
+    for(int i = 0; i < cut_cache.size(); i++){
+        CachedCut& cached = cut_cache[i];
+        if(cached.flow > flow)
+            continue;
+        if(best >= 0 && cached.edges.size() >= cut_cache[best].edges.size())
+            continue;
+        bool disabled = true;
+        for(int edgeID:cached.edges){
+            if(g_over.edgeEnabled(edgeID)){
+                disabled = false;
+                break;
+            }
+        }
+        if(disabled)
+            best = i;
+    }
+    if(best < 0){
+        stats_cut_cache_misses++;
+        return false;
+    }
+    stats_cut_cache_hits++;
+    for(int edgeID:cut_cache[best].edges){
+        Lit l = mkLit(outer->getEdgeVar(edgeID), false);
+        assert(outer->value(l) == l_False);
+        conflict.push(outer->toSolver(l));
+    }
+    return true;
+}
+
+//Remembers the min-cut in cut_edges, which limits the maximum flow to 'flow' while its edges are disabled
+template<typename Weight, typename Graph>
+void MaxflowDetector<Weight, Graph>::cacheCut(Weight flow){
+    if(opt_conflict_min_cut_cache <= 0 || outer->hasBitVectorEdges())
+        return;
+    int i;
+    if(cut_cache.size() < opt_conflict_min_cut_cache){
+        i = cut_cache.size();
+        cut_cache.emplace_back();
+    }else{
+        i = cut_cache_next;
+        cut_cache_next = (cut_cache_next + 1) % cut_cache.size();
+    }
+    cut_cache[i].flow = flow;
+    cut_cache[i].edges = cut_edges;
+}
+
 template<typename Weight, typename Graph>
 void MaxflowDetector<Weight, Graph>::buildMaxFlowTooLowReason(Weight maxflow, vec<Lit>& conflict, bool force_maxflow){
     //Consider using the kernigan-lin partitioning heuristic to get a separating cut here, instead of maxflow?
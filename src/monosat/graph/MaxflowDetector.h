@@ -159,6 +159,18 @@ public:
 
     std::vector<MaxFlowEdge> cut;
 
+    //A min-cut learnt in analyzeMaxFlowLEQ(): while all of its edges are disabled, the maximum flow is at most 'flow'.
+    struct CachedCut {
+        Weight flow = 0;
+        std::vector<int> edges;
+    };
+    std::vector<CachedCut> cut_cache;
+    int cut_cache_next = 0;//the next entry to overwrite, once the cache is full
+    int cut_cache_edges = 0;//the number of edges in g_over when the cached cuts were learnt
+    std::vector<int> cut_edges;
+    int64_t stats_cut_cache_hits = 0;
+    int64_t stats_cut_cache_misses = 0;
+
     vec<MaxFlowEdge> tmp_cut;
     vec<int> visit;
     vec<bool> seen;
@@ -191,6 +203,10 @@ public:
 
     void analyzeMaxFlowLEQ(Weight flow, vec<Lit>& conflict, bool force_maxflow = false);
 
+    bool findCachedCut(Weight flow, vec<Lit>& conflict);
+
+    void cacheCut(Weight flow);
+
     void analyzeMaxFlowGEQ(Weight flow, vec<Lit>& conflict);
 
     void buildMaxFlowTooHighReason(Weight flow, vec<Lit>& conflict);
@@ -261,6 +277,10 @@ public:
         if(opt_theory_internal_vsids){
             printf("\tVsids decisions: %" PRId64 "\n", n_stats_vsids_decisions);
         }
+        if(stats_cut_cache_hits + stats_cut_cache_misses > 0){
+            printf("\tMin-cut cache: %" PRId64 " hits, %" PRId64 " misses\n", stats_cut_cache_hits,
+                   stats_cut_cache_misses);
+        }
 
     }
 
@@ -36,7 +36,10 @@ using namespace Monosat;
 
 template<typename Weight, typename Graph>
 ReachDetector<Weight, Graph>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>* _outer, Graph& g_under,
-                                            Graph& g_over, Graph& cutGraph, int from, double seed) :
+                                            Graph& g_over, Graph& cutGraph, int from, double seed,
+                                            MultiSourceReach<Weight, Graph>* shared_under,
+                                            MultiSourceReach<Weight, Graph>* shared_over,
+                                            CSRGraph<Weight, Graph>* csr_under, CSRGraph<Weight, Graph>* csr_over) :
         Detector(_detectorID), outer(_outer), g_under(g_under), g_over(g_over), cutGraph(cutGraph), within(-1),
         source(from), rnd_seed(seed){
 
@@ -82,7 +85,19 @@ ReachDetector<Weight, Graph>::ReachDetector(int _detectorID, GraphTheorySolver<W
 
     positiveReachStatus = new ReachDetector<Weight, Graph>::ReachStatus(*this, true);
     negativeReachStatus = new ReachDetector<Weight, Graph>::ReachStatus(*this, false);
-    if(reachalg == ReachAlg::ALG_BFS){
+    if(reachalg == ReachAlg::ALG_BFS && csr_under && csr_over){
+        typedef BFSReachability<Weight, CSRGraph<Weight, Graph>, ReachDetector<Weight, Graph>::ReachStatus> CSRBFS;
+        if(!opt_encode_reach_underapprox_as_sat){
+            underapprox_detector = new CSRBFS(from, *csr_under, *(positiveReachStatus), 1);
+        }else{
+            underapprox_fast_detector = new CSRBFS(from, *csr_under, *(positiveReachStatus), 1);
+        }
+        overapprox_reach_detector = new CSRBFS(from, *csr_over, *(negativeReachStatus), -1);
+
+        underapprox_path_detector = underapprox_detector;
+        overapprox_path_detector = overapprox_reach_detector;
+        negative_distance_detector = (Distance<int>*) overapprox_path_detector;
+    }else if(reachalg == ReachAlg::ALG_BFS){
         if(!opt_encode_reach_underapprox_as_sat){
             underapprox_detector = new BFSReachability<Weight, Graph, ReachDetector<Weight, Graph>::ReachStatus>(from,
                                                                                                                  g_under,
@@ -246,6 +261,17 @@ ReachDetector<Weight, Graph>::ReachDetector(int _detectorID, GraphTheorySolver<W
         //RamalReps now supports finding paths
 
         negative_distance_detector = (Distance<int>*) overapprox_path_detector;
+    }else if(reachalg == ReachAlg::ALG_MULTISOURCE && shared_under && shared_over){
+        typedef typename MultiSourceReach<Weight, Graph>::template Column<ReachDetector<Weight, Graph>::ReachStatus> SharedReach;
+        if(!opt_encode_reach_underapprox_as_sat){
+            underapprox_detector = new SharedReach(*shared_under, from, *positiveReachStatus, 1);
+            underapprox_path_detector = underapprox_detector;
+        }else{
+            underapprox_fast_detector = new SharedReach(*shared_under, from, *positiveReachStatus, 1);
+            underapprox_path_detector = underapprox_fast_detector;
+        }
+        overapprox_reach_detector = new SharedReach(*shared_over, from, *negativeReachStatus, -1);
+        overapprox_path_detector = overapprox_reach_detector;
     }else{
         if(!opt_encode_reach_underapprox_as_sat){
             underapprox_detector = new UnweightedDijkstra<Weight, Graph, ReachDetector<Weight, Graph>::ReachStatus>(
@@ -1553,6 +1579,18 @@ void ReachDetector<Weight, Graph>::buildReason(Lit p, vec<Lit>& reason, CRef mar
     outer->toSolver(reason);
 }
 
+template<typename Weight, typename Graph>
+void ReachDetector<Weight, Graph>::preparePropagation(){
+    //Only the update() calls from propagate(); they return immediately there if the graphs have not changed since.
+    //The reach status callbacks only record changed nodes in this detector.
+    if(underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0)){
+        underapprox_detector->update();
+    }
+    if(overapprox_reach_detector && (!opt_detect_pure_theory_lits || unassigned_negatives > 0)){
+        overapprox_reach_detector->update();
+    }
+}
+
 template<typename Weight, typename Graph>
 bool ReachDetector<Weight, Graph>::propagate(vec<Lit>& conflict){
 
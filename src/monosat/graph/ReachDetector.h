@@ -28,6 +28,8 @@
 #include "monosat/dgl/Dijkstra.h"
 #include "monosat/dgl/BFS.h"
 #include "monosat/dgl/DFS.h"
+#include "monosat/dgl/MultiSourceReach.h"
+#include "monosat/dgl/CSRGraph.h"
 
 #include "monosat/core/SolverTypes.h"
 #include "monosat/mtl/Map.h"
@@ -300,6 +302,8 @@ public:
 
     bool propagate(vec<Lit>& conflict) override;
 
+    void preparePropagation() override;
+
     void buildReachReason(int node, vec<Lit>& conflict);
 
     void buildNonReachReason(int node, vec<Lit>& conflict, bool force_maxflow = false);
@@ -320,8 +324,14 @@ public:
 
     void dbg_sync_reachability();
 
+    //If 'shared_under' and 'shared_over' are supplied (with the multisource reach algorithm), reachability is read
+    //from those shared engines, rather than computed separately for this source.
+    //If 'csr_under' and 'csr_over' are supplied (with the bfs reach algorithm), the traversals run over those
+    //compressed snapshots of g_under and g_over.
     ReachDetector(int _detectorID, GraphTheorySolver<Weight>* _outer, Graph& g_under, Graph& g_over, Graph& cutGraph,
-                  int _source, double seed = 1);
+                  int _source, double seed = 1, MultiSourceReach<Weight, Graph>* shared_under = nullptr,
+                  MultiSourceReach<Weight, Graph>* shared_over = nullptr, CSRGraph<Weight, Graph>* csr_under = nullptr,
+                  CSRGraph<Weight, Graph>* csr_over = nullptr);
 
     ~ReachDetector() override{
 
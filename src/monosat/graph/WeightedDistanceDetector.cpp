@@ -21,6 +21,7 @@
 
 #include "monosat/core/Config.h"
 #include "monosat/dgl/RamalReps.h"
+#include "monosat/dgl/EvenShiloach.h"
 #include "monosat/dgl/EdmondsKarp.h"
 #include "monosat/dgl/EdmondsKarpAdj.h"
 #include "monosat/dgl/KohliTorr.h"
@@ -93,6 +94,19 @@ WeightedDistanceDetector<Weight, Graph>::WeightedDistanceDetector(int _detectorI
                                                                                                                *(negativeDistanceStatus),
                                                                                                                -2);
         underapprox_weighted_path_detector = underapprox_weighted_distance_detector; //new Dijkstra<Weight>(from, _g);
+    }else if(distalg == DistAlg::ALG_EVEN_SHILOACH){
+        //Truncated at the largest distance in the constraints (see updateMaxDistance())
+        underapprox_weighted_distance_detector =
+                new EvenShiloach<Weight, Graph, typename WeightedDistanceDetector<Weight, Graph>::DistanceStatus>(from, _g,
+                                                                                                                  *(positiveDistanceStatus),
+                                                                                                                  0);
+        overapprox_weighted_distance_detector =
+                new EvenShiloach<Weight, Graph, typename WeightedDistanceDetector<Weight, Graph>::DistanceStatus>(from,
+                                                                                                                  _antig,
+                                                                                                                  *(negativeDistanceStatus),
+                                                                                                                  0);
+        underapprox_weighted_path_detector = underapprox_weighted_distance_detector;
+        supports_max_distance = true;
     }else{
         underapprox_weighted_distance_detector =
                 new Dijkstra<Weight, Graph, typename WeightedDistanceDetector<Weight, Graph>::DistanceStatus>(from, _g,
@@ -152,6 +166,28 @@ void WeightedDistanceDetector<Weight, Graph>::addWeightedShortestPathLit(int fro
         reach_lit_map.push({-1, -1, None});
     }
     reach_lit_map[reach_var - first_reach_var] = {to, weighted_dist_lits.size() - 1, WeightedConstLit};
+    if(weighted_dist_lits.size() == 1 || within_distance > max_weighted_distance){
+        max_weighted_distance = within_distance;
+    }
+    updateMaxDistance();
+}
+
+template<typename Weight, typename Graph>
+void WeightedDistanceDetector<Weight, Graph>::updateMaxDistance(){
+    //Distances can only be truncated if every constraint compares against a constant
+    if(!supports_max_distance || !opt_compute_max_distance || weighted_dist_bv_lits.size() > 0
+       || weighted_dist_lits.size() == 0){
+        if(distances_truncated){
+            Weight unbounded = -1;
+            underapprox_weighted_distance_detector->setMaxDistance(unbounded);
+            overapprox_weighted_distance_detector->setMaxDistance(unbounded);
+            distances_truncated = false;
+        }
+        return;
+    }
+    underapprox_weighted_distance_detector->setMaxDistance(max_weighted_distance);
+    overapprox_weighted_distance_detector->setMaxDistance(max_weighted_distance);
+    distances_truncated = true;
 }
 
 template<typename Weight, typename Graph>
@@ -180,6 +216,7 @@ void WeightedDistanceDetector<Weight, Graph>::addWeightedShortestPathBVLit(int f
         reach_lit_map.push({-1, -1, None});
     }
     reach_lit_map[reach_var - first_reach_var] = {to, weighted_dist_bv_lits.size() - 1, WeightedBVLit};
+    updateMaxDistance();
 }
 
 
@@ -292,7 +329,9 @@ void WeightedDistanceDetector<Weight, Graph>::buildDistanceLEQReason(int to, Wei
 template<typename Weight, typename Graph>
 void WeightedDistanceDetector<Weight, Graph>::analyzeDistanceGTReason(int to, Weight& min_distance, vec<Lit>& conflict,
                                                                       bool strictComparison){
-    bool reaches = overapprox_weighted_distance_detector->connected(to);
+    //If the distances are truncated, then 'to' may be reachable even though it is reported unreachable; in that case
+    //the min-cut is not a valid reason, and neither are the (truncated) level 0 distances used below.
+    bool reaches = distances_truncated || overapprox_weighted_distance_detector->connected(to);
     if(!reaches && opt_conflict_min_cut && conflict_flow){
 
         cut.clear();
@@ -358,7 +397,7 @@ void WeightedDistanceDetector<Weight, Graph>::analyzeDistanceGTReason(int to, We
                 }
                 assert(from != u);
 
-                if(has_weighted_shortest_paths_overapprox && reaches){
+                if(has_weighted_shortest_paths_overapprox && !distances_truncated && reaches){
                     //This is an optional optimization: if we know that even with all possible edges enabled, the shortest path to from + 1 is >= than the current distance to this node, enabling this edge cannot decrease the shortest path,
                     //and so we don't need to consider this edge
                     Weight current_dist = overapprox_weighted_distance_detector->distance(u);
@@ -526,7 +565,7 @@ void WeightedDistanceDetector<Weight, Graph>::buildReason(Lit p, vec<Lit>& reaso
 
 template<typename Weight, typename Graph>
 void WeightedDistanceDetector<Weight, Graph>::updateShortestPaths(){
-    if(opt_shortest_path_prune_dist && outer->decisionLevel() == 0){
+    if(opt_shortest_path_prune_dist && outer->decisionLevel() == 0 && !distances_truncated){
         //only update these distances at level 0, to ensure they are a valid over approximate of the shortest possible path to each node
 
         has_weighted_shortest_paths_overapprox = true;
@@ -67,6 +67,11 @@ public:
     Distance<Weight>* underapprox_weighted_distance_detector = nullptr;
     Distance<Weight>* overapprox_weighted_distance_detector = nullptr;
     Distance<Weight>* underapprox_weighted_path_detector = nullptr;
+    //True if the distance algorithms support setMaxDistance(), and whether they are currently truncated at
+    //max_weighted_distance (nodes further than that are reported as unreachable)
+    bool supports_max_distance = false;
+    bool distances_truncated = false;
+    Weight max_weighted_distance = 0;
 
 
     //vec<Lit>  reach_lits;
@@ -305,6 +310,9 @@ public:
 
     void addWeightedShortestPathLit(int from, int to, Var reach_var, Weight within_distance, bool strictComparison);
 
+    //Truncates the distance algorithms at the largest constant distance in the constraints, if possible
+    void updateMaxDistance();
+
     void
     addWeightedShortestPathBVLit(int from, int to, Var reach_var, const BitVector <Weight>& bv, bool strictComparison);
 
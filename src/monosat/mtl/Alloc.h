@@ -30,24 +30,34 @@ namespace Monosat {
 
 template<class T>
 class RegionAllocator {
-    T* memory;
-    uint32_t sz;
-    uint32_t cap;
-    uint32_t wasted_;
-
-    void capacity(uint32_t min_cap);
-
 public:
     // TODO: make this a class for better type-checking?
+#ifdef MONOSAT_LARGE_CLAUSE_ARENA
+    //64-bit references allow for regions larger than 2^32 units, at the cost of doubling the size of each reference
+    typedef uint64_t Ref;
+    enum : uint64_t {
+        Ref_Undef = UINT64_MAX
+    };
+#else
     typedef uint32_t Ref;
     enum {
         Ref_Undef = UINT32_MAX
     };
+#endif
+private:
+    T* memory;
+    Ref sz;
+    Ref cap;
+    Ref wasted_;
+
+    void capacity(Ref min_cap);
+
+public:
     enum {
         Unit_Size = sizeof(uint32_t)
     };
 
-    explicit RegionAllocator(uint32_t start_cap = 1024 * 1024) :
+    explicit RegionAllocator(Ref start_cap = 1024 * 1024) :
             memory(NULL), sz(0), cap(0), wasted_(0){
         capacity(start_cap);
     }
@@ -57,11 +67,11 @@ public:
             ::free(memory);
     }
 
-    uint32_t size() const{
+    Ref size() const{
         return sz;
     }
 
-    uint32_t wasted() const{
+    Ref wasted() const{
         return wasted_;
     }
 
@@ -112,17 +122,17 @@ public:
 };
 
 template<class T>
-void RegionAllocator<T>::capacity(uint32_t min_cap){
+void RegionAllocator<T>::capacity(Ref min_cap){
     if(cap >= min_cap)
         return;
 
-    uint32_t prev_cap = cap;
+    Ref prev_cap = cap;
     while(cap < min_cap){
         // NOTE: Multiply by a factor (13/8) without causing overflow, then add 2 and make the
         // result even by clearing the least significant bit. The resulting sequence of capacities
         // is carefully chosen to hit a maximum capacity that is close to the '2^32-1' limit when
         // using 'uint32_t' as indices so that as much as possible of this space can be used.
-        uint32_t delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
+        Ref delta = ((cap >> 1) + (cap >> 3) + 2) & ~(Ref) 1;
         cap += delta;
 
         if(cap <= prev_cap)
@@ -140,7 +150,7 @@ typename RegionAllocator<T>::Ref RegionAllocator<T>::alloc(int size){
     assert(size > 0);
     capacity(sz + size);
 
-    uint32_t prev_sz = sz;
+    Ref prev_sz = sz;
     sz += size;
 
     // Handle overflow:
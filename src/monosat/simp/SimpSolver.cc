@@ -136,8 +136,15 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp){
 
     if(result == l_True)
         result = Solver::solve_();
-    else if(verbosity >= 1)
-        printf("===============================================================================\n");
+    else{
+        if(proof){
+            vec<Lit> empty;
+            logLevelZeroTheoryReasons();
+            logProof(ProofWriter::Step::Add, empty);
+        }
+        if(verbosity >= 1)
+            printf("===============================================================================\n");
+    }
 
     if(result == l_True)
         extendModel();
@@ -210,11 +217,22 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l){
     // if (!find(subsumption_queue, &c))
     subsumption_queue.insert(cr);
 
+    if(proof){
+        //the strengthened clause must be in the proof before the original is deleted
+        proof_strengthened.clear();
+        for(Lit lit:c){
+            if(lit != l && value(lit) != l_False)
+                proof_strengthened.push(lit);
+        }
+        logProof(ProofWriter::Step::Add, proof_strengthened);
+    }
+
     if(c.size() == 2){
         removeClause(cr);
         c.strengthen(l);
     }else{
         detachClause(cr, true);
+        logProof(ProofWriter::Step::Delete, c);
         int size = c.size();
         //remove any false lits from this clause
         for(int i = 0; i < c.size(); i++){
@@ -539,18 +557,29 @@ bool SimpSolver::eliminateVar(Var v){
             mkElimClause(elimclauses, v, ca[pos[i]]);
         mkElimClause(elimclauses, ~mkLit(v));
     }
+    vec<Lit>& resolvent = add_tmp;
+    if(proof){
+        //the resolvents must be in the proof before the clauses they were resolved from are deleted
+        for(int i = 0; i < pos.size(); i++)
+            for(int j = 0; j < neg.size(); j++)
+                if(merge(ca[pos[i]], ca[neg[j]], v, resolvent))
+                    logProof(ProofWriter::Step::Add, resolvent);
+    }
     bool all_derived = true;
     for(int i = 0; i < cls.size(); i++){
         all_derived &= ca[cls[i]].derivedClause();
         removeClause(cls[i]);
     }
     // Produce clauses in cross product:
-    vec<Lit>& resolvent = add_tmp;
+    adding_derived_clauses = true;
     for(int i = 0; i < pos.size(); i++)
         for(int j = 0; j < neg.size(); j++)
             if(merge(ca[pos[i]], ca[neg[j]], v, resolvent) &&
-               !addClause_(resolvent, all_derived))//should this clause always be treated as derived?
+               !addClause_(resolvent, all_derived)){//should this clause always be treated as derived?
+                adding_derived_clauses = false;
                 return false;
+            }
+    adding_derived_clauses = false;
 
     // Free occurs list for this variable:
     occurs[v].clear(true);
@@ -560,6 +589,10 @@ bool SimpSolver::eliminateVar(Var v){
         watches[mkLit(v)].clear(true);
     if(watches[~mkLit(v)].size() == 0)
         watches[~mkLit(v)].clear(true);
+    if(watches_bin[mkLit(v)].size() == 0)
+        watches_bin[mkLit(v)].clear(true);
+    if(watches_bin[~mkLit(v)].size() == 0)
+        watches_bin[~mkLit(v)].clear(true);
 
     return backwardSubsumptionCheck();
 }
@@ -585,10 +618,14 @@ bool SimpSolver::substitute(Var v, Lit x){
             Lit p = c[j];
             subst_clause.push(var(p) == v ? x ^ sign(p) : p);
         }
+        logProof(ProofWriter::Step::Add, subst_clause);
 
         removeClause(cls[i]);
 
-        if(!addClause_(subst_clause))//should this clause be treated as derived?
+        adding_derived_clauses = true;
+        bool added = addClause_(subst_clause);//should this clause be treated as derived?
+        adding_derived_clauses = false;
+        if(!added)
             return (ok = false);
     }
 
@@ -725,6 +762,35 @@ bool SimpSolver::eliminate(bool turn_off_elim){
     return ok;
 }
 
+bool SimpSolver::inprocess(){
+    if(!Solver::inprocess())
+        return false;
+    if(!use_simplification || !use_elim)
+        return true;
+    //Give every (unfrozen) variable another chance at elimination, now that the clause database has changed.
+    //Theory atoms are frozen, and are never eliminated.
+    for(Var v = 0; v < nVars(); v++)
+        updateElimHeap(v);
+    if(!eliminate(false))
+        return false;
+
+    //learnt clauses over eliminated variables are no longer needed
+    int i, j;
+    for(i = j = 0; i < learnts.size(); i++){
+        const Clause& c = ca[learnts[i]];
+        bool has_eliminated = false;
+        for(int k = 0; k < c.size() && !has_eliminated; k++)
+            has_eliminated = isEliminated(var(c[k]));
+        if(has_eliminated && !locked(c))
+            Solver::removeClause(learnts[i]);
+        else
+            learnts[j++] = learnts[i];
+    }
+    learnts.shrink(i - j);
+    checkGarbage();
+    return ok;
+}
+
 void SimpSolver::cleanUpClauses(){
     occurs.cleanAll();
     int i, j;
@@ -769,7 +835,7 @@ void SimpSolver::garbageCollect(){
     relocAll(to);
     Solver::relocAll(to);
     if(verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n",
-               ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+               (uint64_t) ca.size() * ClauseAllocator::Unit_Size, (uint64_t) to.size() * ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
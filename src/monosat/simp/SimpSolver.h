@@ -80,7 +80,7 @@ public:
     // Variable mode:
     //
     void setFrozen(Var v, bool b); // If a variable is frozen it will not be eliminated.
-    bool isEliminated(Var v) const;
+    bool isEliminated(Var v) const override;
 
     // Alternative freeze interface (may replace 'setFrozen()'):
     void freezeVar(Var v);         // Freeze one variable so it will not be eliminated.
@@ -237,6 +237,7 @@ protected:
     // Temporaries:
     //
     CRef bwdsub_tmpunit;
+    vec<Lit> proof_strengthened;
 
     // Main internal methods:
     //
@@ -262,6 +263,8 @@ protected:
 
     void removeClause(CRef cr);
 
+    bool inprocess() override;
+
     bool strengthenClause(CRef cr, Lit l);
 
     void cleanUpClauses();
@@ -0,0 +1,89 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/utils/ThreadPool.h"
+
+namespace Monosat {
+
+ThreadPool::ThreadPool(int n_threads){
+    for(int i = 1; i < n_threads; i++){
+        workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done = true;
+        cv_start.notify_all();
+    }
+    for(std::thread& t:workers)
+        t.join();
+}
+
+void ThreadPool::work(){
+    int i;
+    while((i = next_task.fetch_add(1)) < batch_size){
+        (*batch)(i);
+    }
+}
+
+void ThreadPool::run(){
+    int seen_generation = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        cv_start.wait(lock, [&]{ return done || generation != seen_generation; });
+        if(done)
+            return;
+        seen_generation = generation;
+        n_busy++;
+        lock.unlock();
+        work();
+        lock.lock();
+        if(--n_busy == 0)
+            cv_done.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(int n, const std::function<void(int)>& task){
+    if(n <= 0)
+        return;
+    if(workers.empty() || n == 1){
+        for(int i = 0; i < n; i++)
+            task(i);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        batch = &task;
+        batch_size = n;
+        next_task = 0;
+        generation++;
+        cv_start.notify_all();
+    }
+    work();
+    //Wait until every worker that joined this batch has finished it. Workers that wake up after all the tasks were
+    //taken find none left, and so never touch 'task' after this returns.
+    std::unique_lock<std::mutex> lock(mutex);
+    cv_done.wait(lock, [&]{ return n_busy == 0 && next_task >= batch_size; });
+    batch = nullptr;
+}
+};
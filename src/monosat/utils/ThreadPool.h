@@ -0,0 +1,72 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Monosat {
+
+//A fixed set of worker threads, for running batches of independent tasks from a single (solver) thread.
+//The workers sleep between batches.
+class ThreadPool {
+public:
+    //Creates n_threads-1 worker threads; the thread that calls parallelFor() is the remaining one.
+    explicit ThreadPool(int n_threads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int nThreads() const{
+        return workers.size() + 1;
+    }
+
+    //Calls task(i) for each i in [0,n), spread over the workers and the calling thread, and returns once all of the
+    //calls have finished. The order in which the calls are made is unspecified, so the tasks must be independent.
+    void parallelFor(int n, const std::function<void(int)>& task);
+
+private:
+    void run();
+
+    void work();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cv_start;
+    std::condition_variable cv_done;
+    const std::function<void(int)>* batch = nullptr;
+    int batch_size = 0;
+    std::atomic<int> next_task{0};
+    int n_busy = 0;
+    int generation = 0;
+    bool done = false;
+};
+};
+#endif /* THREADPOOL_H_ */